@@ -0,0 +1,509 @@
+// FleetBench: times each system on its own against synthetic worlds.
+//
+// Usage: FleetBench [--drones 1000,10000,100000] [--ticks N]
+// Results are written to stdout as JSON, logs go to stderr.
+// Exits with 1 if pooled drone/fleet spawning or AI planning allocates in steady state.
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Config.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/Random.hpp"
+
+#include "Game/GameEntityManager.hpp"
+#include "Game/Builder.hpp"
+#include "Components/DroneComponent.hpp"
+
+#include "Systems/MovementSystem.hpp"
+#include "Systems/CombatSystem.hpp"
+#include "Systems/ShieldSystem.hpp"
+#include "Systems/ProductionSystem.hpp"
+#include "Systems/LabelUpdateSystem.hpp"
+#include "Systems/SnapshotSystem.hpp"
+#include "Systems/RenderSystem.hpp"
+#include "Systems/AI/PerceptionSystem.hpp"
+#include "Systems/AI/PlanSystem.hpp"
+
+// ─── Allocation counting ───
+// Every heap allocation in the process goes through these replacements.
+
+namespace {
+    std::atomic<unsigned long long> allocationCount{0};
+}
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace Bench {
+
+    const float TICK_DT = 1.f / Config::SIMULATION_TICK_HZ;
+    const unsigned int STRUCTURE_COUNT = 200;
+    const unsigned int FLEET_SIZE = 20;
+    const unsigned int PLAN_GARRISON_COUNT = 1000;
+
+    // Render target that accepts draw calls but never reaches OpenGL:
+    // setActive() fails, so sf::RenderTarget::draw returns before issuing GL calls.
+    // Everything RenderSystem does on the CPU before drawing still runs.
+    class NullRenderTarget : public sf::RenderTarget {
+    public:
+        sf::Vector2u getSize() const override { return {Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT}; }
+        bool setActive(bool active = true) override { return false; }
+    };
+
+    struct Result {
+        std::string system;
+        std::size_t drones = 0;
+        std::size_t entities = 0;   // Entities the system works on
+        unsigned int ticks = 0;
+        double nsPerTick = 0.0;
+        double nsPerEntity = 0.0;
+        double allocationsPerTick = 0.0;
+    };
+
+    // Single drones as their own entities. Gameplay only launches fleets, so these are bench-only:
+    // slim archetype, entities from the manager pool, released with destroyDrone.
+    EntityID createDrone(Game::GameEntityManager& entityManager, unsigned int index = 0, Components::Faction faction = Components::Faction::NEUTRAL, sf::Vector2f position = {0.f, 0.f}) {
+        EntityID droneID = entityManager.acquireEntity();
+
+        entityManager.addComponent<Components::DroneComponent>(droneID, index);
+        entityManager.addComponent<Components::TransformComponent>(droneID, position, 0.f, sf::Vector2f(1, 1));
+        entityManager.addComponent<Components::MoveComponent>(droneID, Config::DRONE_SPEED, 0.f);
+        entityManager.addComponent<Components::FactionComponent>(droneID, faction);
+        entityManager.addComponent<Components::AttackOrderComponent>(droneID);
+
+        return droneID;
+    }
+
+    void destroyDrone(Game::GameEntityManager& entityManager, EntityID droneID) {
+        entityManager.releaseEntity<
+            Components::DroneComponent,
+            Components::TransformComponent,
+            Components::MoveComponent,
+            Components::FactionComponent,
+            Components::AttackOrderComponent>(droneID);
+    }
+
+    // Synthetic world: structures spread over the map, fleets flying between them
+    struct World {
+        Game::GameEntityManager manager;
+        std::vector<EntityID> structures;
+        std::vector<EntityID> fleets;
+    };
+
+    // aiCount: AIs playing the last players; structures are dealt out to the players and neutral in turn
+    std::unique_ptr<World> buildWorld(std::size_t droneCount, unsigned int structureCount = STRUCTURE_COUNT, unsigned int aiCount = 1) {
+        auto world = std::make_unique<World>();
+        auto& manager = world->manager;
+
+        unsigned int playerCount = std::max(2u, aiCount);
+        EntityID gameStateID = manager.createEntity();
+        manager.addComponent<Components::GameStateComponent>(gameStateID, playerCount);
+        for (unsigned int player = playerCount - aiCount + 1; player <= playerCount; ++player) {
+            EntityID aiID = manager.createEntity();
+            manager.addComponent<Components::AIComponent>(aiID, static_cast<Components::Faction>(player));
+        }
+
+        for (unsigned int i = 0; i < structureCount; ++i) {
+            sf::Vector2f position(Utils::getRandomFloat(0.f, Config::MAP_WIDTH), Utils::getRandomFloat(0.f, Config::MAP_HEIGHT));
+            unsigned int turn = i % (playerCount + 1);
+            auto faction = turn < playerCount ? static_cast<Components::Faction>(turn + 1) : Components::Faction::NEUTRAL;
+
+            EntityID id;
+            if (i % 2 == 0) {
+                id = Game::createFactory(manager, "Factory #" + std::to_string(i), position, faction, Utils::getRandomFloat(0.1f, 1.f));
+            } else {
+                id = Game::createPowerPlant(manager, "Power Plant #" + std::to_string(i), position, faction, 1.f, 20);
+            }
+            auto garrisonCount = static_cast<unsigned int>(Utils::getRandomFloat(0.f, 30.f));
+            manager.patchComponent<Components::GarissonComponent>(id, [garrisonCount](auto& garisson){ garisson.setDroneCount(garrisonCount); });
+            manager.getComponent<Components::ShieldComponent>(id)->setShield(Utils::getRandomFloat(0.f, 5.f));
+            world->structures.push_back(id);
+        }
+
+        // In-flight drones travel as fleets of FLEET_SIZE
+        for (std::size_t launched = 0, i = 0; launched < droneCount; ++i) {
+            EntityID origin = world->structures[i % structureCount];
+            EntityID target = world->structures[(i * 7 + 3) % structureCount];
+            auto faction = manager.getComponent<Components::FactionComponent>(origin)->faction;
+            auto size = static_cast<unsigned int>(std::min<std::size_t>(FLEET_SIZE, droneCount - launched));
+
+            // Start far enough away that no fleet arrives during a measurement
+            sf::Vector2f targetPosition = manager.getComponent<Components::TransformComponent>(target)->getPosition();
+            sf::Vector2f offset(Utils::getRandomFloat(-1.f, 1.f), Utils::getRandomFloat(-1.f, 1.f));
+            sf::Vector2f position = targetPosition + offset * 2000.f + sf::Vector2f(200.f, 200.f);
+
+            world->fleets.push_back(Game::createFleet(manager, faction, origin, target, size, position, targetPosition));
+            launched += size;
+        }
+
+        return world;
+    }
+
+    // One AI's decision snapshot: the shared sweep, then its share of it
+    void perceive(Game::GameEntityManager& manager, Components::Faction faction, Components::AIPlan& plan) {
+        auto* aiComponent = manager.getAIComponent(faction);
+        auto& perception = Systems::AI::PerceptionSystem(manager, aiComponent->difficulty.maxDistanceToAttack, TICK_DT);
+        Systems::AI::snapshotPlan(perception, *aiComponent, plan);
+    }
+
+    // Neighbour table entries the faction's garrisons can plan over
+    std::size_t countNeighbours(Game::GameEntityManager& manager, Components::Faction faction) {
+        std::size_t count = 0;
+        const auto& perception = manager.getAIPerception();
+        for (auto origin : perception.summary->getGarrisons(faction)) {
+            auto row = perception.neighbours->getNeighbours(origin);
+            count += row.end() - row.begin();
+        }
+        return count;
+    }
+
+    template<typename View>
+    std::size_t countEntities(View view) {
+        std::size_t count = 0;
+        for (auto entity : view) {
+            (void)entity;
+            count++;
+        }
+        return count;
+    }
+
+    // Runs `setup` untimed and `tick` timed, `ticks` times
+    Result measure(const std::string& system, std::size_t drones, std::size_t entities, unsigned int ticks,
+                   const std::function<void()>& setup, const std::function<void()>& tick) {
+        // Warm up: first calls may size internal buffers
+        setup();
+        tick();
+
+        std::chrono::nanoseconds total{0};
+        unsigned long long allocations = 0;
+        for (unsigned int i = 0; i < ticks; ++i) {
+            setup();
+            unsigned long long allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+            auto start = std::chrono::steady_clock::now();
+            tick();
+            total += std::chrono::steady_clock::now() - start;
+            allocations += allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+        }
+
+        Result result;
+        result.system = system;
+        result.drones = drones;
+        result.entities = entities;
+        result.ticks = ticks;
+        result.nsPerTick = static_cast<double>(total.count()) / ticks;
+        result.nsPerEntity = entities ? result.nsPerTick / entities : 0.0;
+        result.allocationsPerTick = static_cast<double>(allocations) / ticks;
+        return result;
+    }
+
+    void runSuite(std::size_t droneCount, unsigned int ticks, std::vector<Result>& results) {
+        log_info << "Building world with " << droneCount << " drones";
+        auto noSetup = [](){};
+
+        {
+            // Fleets fly analytically and are not moved per tick, only single drones are.
+            // Every drone as its own moving entity, the worst case for the movement loop
+            auto world = buildWorld(0);
+            auto& manager = world->manager;
+            for (std::size_t i = 0; i < droneCount; ++i) {
+                sf::Vector2f target = manager.getComponent<Components::TransformComponent>(world->structures[i % STRUCTURE_COUNT])->getPosition();
+                sf::Vector2f offset(Utils::getRandomFloat(-1.f, 1.f), Utils::getRandomFloat(-1.f, 1.f));
+                EntityID droneID = createDrone(manager, static_cast<unsigned int>(i), Components::Faction::PLAYER_1, target + offset * 2000.f + sf::Vector2f(200.f, 200.f));
+                manager.patchComponent<Components::MoveComponent>(droneID, [&](auto& move){
+                    move.targetPosition = target;
+                    move.moveToTarget = true;
+                });
+            }
+            results.push_back(measure("MovementSystem(drones)", droneCount, droneCount, ticks, noSetup,
+                [&](){ Systems::MovementSystem(manager, TICK_DT); }));
+        }
+        {
+            // Kernels alone on SoA arrays
+            struct {
+                std::vector<float> x, y, targetX, targetY, speed;
+                std::vector<std::uint8_t> arrived;
+            } buffers;
+            for (std::size_t i = 0; i < droneCount; ++i) {
+                buffers.x.push_back(Utils::getRandomFloat(0.f, 5000.f));
+                buffers.y.push_back(Utils::getRandomFloat(0.f, 5000.f));
+            }
+            buffers.targetX.assign(droneCount, 1e6f);
+            buffers.targetY.assign(droneCount, 1e6f);
+            buffers.speed.assign(droneCount, Config::DRONE_SPEED);
+            buffers.arrived.resize(droneCount);
+
+            std::vector<Systems::MovementKernels::Kernel> kernels = {&Systems::MovementKernels::moveScalarAll};
+#ifdef MOVEMENT_KERNELS_X86
+            kernels.push_back(&Systems::MovementKernels::moveSSE);
+#endif
+            if (Systems::MovementKernels::getKernel() != kernels.back()) {
+                kernels.push_back(Systems::MovementKernels::getKernel());
+            }
+            for (auto kernel : kernels) {
+                results.push_back(measure(std::string("MovementKernel(") + Systems::MovementKernels::getKernelName(kernel) + ")", droneCount, droneCount, ticks, noSetup,
+                    [&](){ kernel(buffers.x.data(), buffers.y.data(), buffers.targetX.data(), buffers.targetY.data(),
+                        buffers.speed.data(), TICK_DT, buffers.arrived.data(), droneCount); }));
+            }
+        }
+        {
+            // Steady state: fleets in flight, nobody launches or arrives
+            auto world = buildWorld(droneCount);
+            auto& manager = world->manager;
+            auto entities = countEntities(manager.view<Components::AttackOrderComponent>());
+            results.push_back(measure("CombatSystem", droneCount, entities, ticks, noSetup,
+                [&](){ Systems::CombatSystem(manager, TICK_DT); manager.flushCommands(); }));
+        }
+        {
+            // One garrison launches droneCount drones in a single tick
+            auto world = buildWorld(0);
+            auto& manager = world->manager;
+            EntityID origin = world->structures[0];
+            EntityID target = world->structures[1];
+            std::vector<EntityID> launched;
+            auto setup = [&](){
+                for (auto&& [id, fleet] : manager.view<Components::FleetComponent>().each()) {
+                    launched.push_back(id);
+                }
+                for (auto id : launched) {
+                    Game::destroyFleet(manager, id);
+                }
+                launched.clear();
+                // Drop the arrivals of the destroyed fleets, the clock never advances here
+                Game::GameEntityManager::ScheduledArrival arrival;
+                while (manager.popArrival(std::numeric_limits<double>::infinity(), arrival)) {}
+                manager.patchComponent<Components::GarissonComponent>(origin, [&](auto& garisson){ garisson.setDroneCount(static_cast<unsigned int>(droneCount) + 1); });
+                manager.addOrReplaceComponent<Components::AttackOrderComponent>(origin, origin, target);
+            };
+            // Launches are expensive to set up, a few samples are enough
+            results.push_back(measure("CombatSystem(launch)", droneCount, droneCount, std::min(ticks, 10u), setup,
+                [&](){ Systems::CombatSystem(manager, TICK_DT); manager.flushCommands(); }));
+        }
+        {
+            // Spawn and despawn droneCount pooled drones, steady state must not allocate
+            auto world = buildWorld(0);
+            auto& manager = world->manager;
+            std::vector<EntityID> spawned;
+            spawned.reserve(droneCount);
+            results.push_back(measure("DronePool", droneCount, droneCount, ticks, noSetup,
+                [&](){
+                    for (std::size_t i = 0; i < droneCount; ++i) {
+                        spawned.push_back(createDrone(manager, static_cast<unsigned int>(i), Components::Faction::PLAYER_1));
+                    }
+                    for (auto id : spawned) {
+                        destroyDrone(manager, id);
+                    }
+                    spawned.clear();
+                }));
+        }
+        {
+            auto world = buildWorld(droneCount);
+            auto& manager = world->manager;
+            auto entities = countEntities(manager.view<Components::ShieldComponent>());
+            auto setup = [&](){
+                for (auto&& [id, shield] : manager.view<Components::ShieldComponent>().each()) {
+                    shield.currentShield = 0.f;
+                }
+            };
+            results.push_back(measure("ShieldSystem", droneCount, entities, ticks, setup,
+                [&](){ Systems::ShieldSystem(manager, TICK_DT); }));
+        }
+        {
+            auto world = buildWorld(droneCount);
+            auto& manager = world->manager;
+            auto entities = countEntities(manager.view<Components::FactoryComponent>()) + countEntities(manager.view<Components::PowerPlantComponent>());
+            results.push_back(measure("ProductionSystem", droneCount, entities, ticks, noSetup,
+                [&](){ Systems::ProductionSystem(manager, TICK_DT); }));
+        }
+        {
+            auto world = buildWorld(droneCount);
+            auto& manager = world->manager;
+            auto entities = countEntities(manager.view<Components::TransformComponent, Components::LabelComponent>());
+            results.push_back(measure("LabelUpdateSystem", droneCount, entities, ticks, noSetup,
+                [&](){ Systems::LabelUpdateSystem(manager, TICK_DT); }));
+
+            // Every garrison changes between frames, all labels are re-formatted
+            auto touchAll = [&](){
+                for (auto id : world->structures) {
+                    manager.patchComponent<Components::GarissonComponent>(id, [](auto& garisson){ garisson.incrementDroneCount(); });
+                }
+            };
+            results.push_back(measure("LabelUpdateSystem(dirty)", droneCount, entities, ticks, touchAll,
+                [&](){ Systems::LabelUpdateSystem(manager, TICK_DT); }));
+        }
+        {
+            auto world = buildWorld(droneCount);
+            auto& manager = world->manager;
+            auto entities = manager.getAllEntityIDs().size();
+            Components::AIPlan plan;
+            results.push_back(measure("AI::PerceptionSystem", droneCount, entities, ticks, noSetup,
+                [&](){ perceive(manager, Components::Faction::PLAYER_2, plan); }));
+        }
+        {
+            // Free-for-all: every player an AI and all of them deciding on the same tick
+            auto world = buildWorld(droneCount, STRUCTURE_COUNT, Components::MAX_PLAYERS);
+            auto& manager = world->manager;
+            auto entities = manager.getAllEntityIDs().size();
+            std::vector<Components::AIPlan> plans(Components::MAX_PLAYERS);
+            results.push_back(measure("AI::PerceptionSystem(8 AIs)", droneCount, entities, ticks, noSetup, [&](){
+                auto& perception = Systems::AI::PerceptionSystem(manager, Config::Difficulty{}.maxDistanceToAttack, TICK_DT);
+                for (unsigned int player = 1; player <= Components::MAX_PLAYERS; ++player) {
+                    auto* aiComponent = manager.getAIComponent(static_cast<Components::Faction>(player));
+                    Systems::AI::snapshotPlan(perception, *aiComponent, plans[player - 1]);
+                }
+            }));
+        }
+        {
+            auto world = buildWorld(droneCount);
+            auto& manager = world->manager;
+            Components::AIPlan plan;
+            auto setup = [&](){ perceive(manager, Components::Faction::PLAYER_2, plan); };
+            setup();
+            std::size_t entities = countNeighbours(manager, Components::Faction::PLAYER_2);
+            results.push_back(measure("AI::PlanSystem", droneCount, entities, ticks, setup,
+                [&](){ Systems::AI::PlanSystem(plan, std::numeric_limits<std::size_t>::max()); }));
+        }
+        {
+            // Hardest preset on a crowded map: every garrison is in reach of every other
+            auto world = buildWorld(droneCount, PLAN_GARRISON_COUNT);
+            auto& manager = world->manager;
+            manager.getAIComponent()->difficulty.setLevel("Impossible");
+            Components::AIPlan plan;
+            auto setup = [&](){ perceive(manager, Components::Faction::PLAYER_2, plan); };
+            setup();
+            std::size_t entities = countNeighbours(manager, Components::Faction::PLAYER_2);
+            results.push_back(measure("AI::PlanSystem(impossible)", droneCount, entities, ticks, setup,
+                [&](){ Systems::AI::PlanSystem(plan, std::numeric_limits<std::size_t>::max()); }));
+
+            // What the preset's step budget lets a single tick spend on the same decision
+            results.push_back(measure("AI::PlanSystem(slice)", droneCount, entities, ticks, setup,
+                [&](){ Systems::AI::PlanSystem(plan, plan.stepsPerTick); }));
+        }
+        {
+            auto world = buildWorld(droneCount);
+            auto& manager = world->manager;
+            NullRenderTarget target;
+            Game::RenderCache cache;
+            // Some supply routes between structures
+            for (unsigned int i = 0; i + 1 < STRUCTURE_COUNT; i += 10) {
+                auto faction = manager.getComponent<Components::FactionComponent>(world->structures[i])->faction;
+                manager.addOrReplaceComponent<Components::DroneTransferComponent>(world->structures[i], world->structures[i], world->structures[i + 1], faction);
+            }
+            auto entities = countEntities(manager.view<Components::TransformComponent, Components::ShapeComponent>()) + droneCount;
+
+            // Copy of the world the simulation thread publishes every tick
+            Game::RenderSnapshot snapshot;
+            results.push_back(measure("SnapshotSystem", droneCount, entities, ticks, noSetup,
+                [&](){ Systems::SnapshotSystem(manager, snapshot, 0, TICK_DT); }));
+
+            results.push_back(measure("RenderSystem(cpu)", droneCount, entities, ticks, noSetup,
+                [&](){ Systems::RenderSystem(snapshot, target, 1.f, cache); }));
+
+            // Camera zoomed in on a quarter of the map: the snapshot takes the grid cells in view
+            // only, and drawing it costs what is on screen
+            NullRenderTarget zoomedTarget;
+            zoomedTarget.setView(sf::View(sf::FloatRect(0.f, 0.f, Config::MAP_WIDTH / 4.f, Config::MAP_HEIGHT / 4.f)));
+            sf::FloatRect zoomedView = Game::RenderSnapshot::getCullRect(zoomedTarget.getView());
+            Game::RenderSnapshot zoomedSnapshot;
+            Game::RenderCache zoomedCache;
+            results.push_back(measure("SnapshotSystem(zoomed)", droneCount, entities, ticks, noSetup,
+                [&](){ Systems::SnapshotSystem(manager, zoomedSnapshot, 0, TICK_DT, &zoomedView); }));
+            results.push_back(measure("RenderSystem(cpu, zoomed)", droneCount, entities, ticks, noSetup,
+                [&](){ Systems::RenderSystem(zoomedSnapshot, zoomedTarget, 1.f, zoomedCache); }));
+        }
+    }
+
+    void writeJson(std::ostream& out, const std::vector<Result>& results) {
+        out << "{\n  \"results\": [\n";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const auto& r = results[i];
+            out << "    {\"system\": \"" << r.system << "\""
+                << ", \"drones\": " << r.drones
+                << ", \"entities\": " << r.entities
+                << ", \"ticks\": " << r.ticks
+                << ", \"ns_per_tick\": " << r.nsPerTick
+                << ", \"ns_per_entity\": " << r.nsPerEntity
+                << ", \"allocations_per_tick\": " << r.allocationsPerTick
+                << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+
+    std::vector<std::size_t> parseSizes(const std::string& list) {
+        std::vector<std::size_t> sizes;
+        std::stringstream ss(list);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            if (!item.empty()) {
+                sizes.push_back(std::stoul(item));
+            }
+        }
+        return sizes;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // Keep stdout clean for the JSON report
+    logger::Log::stream = &std::cerr;
+
+    std::vector<std::size_t> sizes = {1000, 10000, 100000};
+    unsigned int ticks = 100;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--drones" && i + 1 < argc) {
+            sizes = Bench::parseSizes(argv[++i]);
+        } else if (arg == "--ticks" && i + 1 < argc) {
+            ticks = std::max(1ul, std::stoul(argv[++i]));
+        } else {
+            log_err << "Usage: " << argv[0] << " [--drones 1000,10000,100000] [--ticks N]";
+            return 1;
+        }
+    }
+
+    Utils::seedRandom(1234);
+
+    std::vector<Bench::Result> results;
+    for (auto size : sizes) {
+        Bench::runSuite(size, ticks, results);
+    }
+
+    Bench::writeJson(std::cout, results);
+
+    // Pooled spawns and AI planning are expected to be allocation free once warmed up
+    int status = 0;
+    for (const auto& result : results) {
+        bool allocationFree = result.system == "DronePool" || result.system == "CombatSystem(launch)" ||
+                              result.system.rfind("AI::PlanSystem", 0) == 0;
+        if (allocationFree && result.allocationsPerTick > 0.0) {
+            log_err << result.system << " allocated " << result.allocationsPerTick << " times per tick with " << result.drones << " drones";
+            status = 1;
+        }
+    }
+    return status;
+}
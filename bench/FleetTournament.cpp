@@ -0,0 +1,437 @@
+// FleetTournament: plays headless AI-vs-AI matches in parallel, one simulation per thread.
+//
+// Usage: FleetTournament [--ai Easy,Medium,Hard,Impossible] [--players N] [--matches N] [--seed S] [--ticks N]
+//                        [--tick-rate HZ] [--threads N] [--format json|csv]
+// An AI is a difficulty preset with optional overrides, e.g. Hard:interval=2:orders=20:distance=800:steps=64.
+// Two players: every AI plays every other on both sides of the same N seeded maps.
+// More: free-for-all matches, the AIs taking the seats in turn, every rotation on each map.
+// Results are written to stdout as JSON (or CSV pairings / per-AI records), logs go to stderr.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Config.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/JobSystem.hpp"
+
+#include "Game/Simulation.hpp"
+#include "Components/FactionComponent.hpp"
+
+namespace Tournament {
+
+    struct Options {
+        std::vector<std::string> ai = {"Easy", "Medium", "Hard", "Impossible"};
+        unsigned int players = 2;       // Per match
+        unsigned int matches = 10;      // Per pairing and side, or per rotation of the seats
+        unsigned int seed = 1;
+        unsigned long ticks = 60 * 60 * 10; // 10 minutes of game time at 60 ticks/s
+        unsigned int tickRate = Config::SIMULATION_TICK_HZ;
+        unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+        bool csv = false;
+    };
+
+    struct Player {
+        std::string name;
+        Config::Difficulty difficulty;
+    };
+
+    // The AI in seat i plays player i + 1
+    struct Match {
+        std::vector<std::size_t> seats;
+        unsigned int seed = 0;
+    };
+
+    struct MatchResult {
+        Components::Faction winner = Components::Faction::NEUTRAL;
+        unsigned long ticks = 0;
+        double seconds = 0.0;
+    };
+
+    struct Tally {
+        unsigned int matches = 0;
+        unsigned int firstWins = 0;
+        unsigned int secondWins = 0;
+        unsigned long ticks = 0;
+        double seconds = 0.0;
+
+        unsigned int draws() const { return matches - firstWins - secondWins; }
+    };
+
+    std::vector<std::string> split(const std::string& list, char separator) {
+        std::vector<std::string> items;
+        std::stringstream ss(list);
+        std::string item;
+        while (std::getline(ss, item, separator)) {
+            if (!item.empty()) {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
+    // Preset name, then key=value overrides separated by ':'
+    bool parsePlayer(const std::string& spec, Player& player) {
+        auto parts = split(spec, ':');
+        if (parts.empty() || !player.difficulty.setLevel(parts[0])) {
+            log_err << "Unknown AI preset in " << spec;
+            return false;
+        }
+        player.name = spec;
+
+        for (std::size_t i = 1; i < parts.size(); ++i) {
+            auto equals = parts[i].find('=');
+            if (equals == std::string::npos) {
+                log_err << "Expected key=value in " << spec << ": " << parts[i];
+                return false;
+            }
+            std::string key = parts[i].substr(0, equals);
+            std::string value = parts[i].substr(equals + 1);
+            try {
+                if (key == "interval") {
+                    player.difficulty.decisionIntervalSec = std::stof(value);
+                } else if (key == "orders") {
+                    player.difficulty.maxExecutionsPerTurn = static_cast<unsigned int>(std::stoul(value));
+                } else if (key == "distance") {
+                    player.difficulty.maxDistanceToAttack = std::stof(value);
+                } else if (key == "steps") {
+                    player.difficulty.planStepsPerTick = static_cast<unsigned int>(std::stoul(value));
+                } else {
+                    log_err << "Unknown AI setting in " << spec << ": " << key;
+                    return false;
+                }
+            } catch (const std::exception&) {
+                log_err << "Bad value in " << spec << ": " << parts[i];
+                return false;
+            }
+        }
+        return true;
+    }
+
+    MatchResult play(const Match& match, const std::vector<Player>& players, const Options& options) {
+        Game::MatchSettings settings;
+        settings.seed = match.seed;
+        settings.headless = true;
+        settings.ai.clear();
+        for (std::size_t seat = 0; seat < match.seats.size(); ++seat) {
+            settings.ai.push_back({static_cast<Components::Faction>(seat + 1), players[match.seats[seat]].difficulty});
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        Game::Simulation simulation(settings);
+        float dt = 1.f / options.tickRate;
+        while (simulation.getTickCount() < options.ticks && !simulation.isGameOver()) {
+            simulation.step(dt);
+        }
+
+        MatchResult result;
+        result.winner = simulation.getWinner();
+        result.ticks = simulation.getTickCount();
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    // Each thread takes the next unplayed match until none are left. Matches share nothing:
+    // every simulation owns its registry, random engine and AI settings, and a thread's
+    // parallelFor calls run inline on a pool of its own instead of the process-wide one.
+    std::vector<MatchResult> playAll(const std::vector<Match>& matches, const std::vector<Player>& players, const Options& options) {
+        std::vector<MatchResult> results(matches.size());
+        std::atomic<std::size_t> next{0};
+
+        auto worker = [&]() {
+            Utils::JobSystem inlinePool(0);
+            Utils::JobSystem::setThreadPool(&inlinePool);
+            for (std::size_t i = next.fetch_add(1); i < matches.size(); i = next.fetch_add(1)) {
+                results[i] = play(matches[i], players, options);
+            }
+            Utils::JobSystem::setThreadPool(nullptr);
+        };
+
+        std::vector<std::thread> threads;
+        for (unsigned int i = 0; i < options.threads; ++i) {
+            threads.emplace_back(worker);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return results;
+    }
+
+    double ratio(double a, double b) {
+        return b > 0.0 ? a / b : 0.0;
+    }
+
+    struct Record {
+        unsigned int matches = 0;
+        unsigned int wins = 0;
+        unsigned int losses = 0;
+
+        unsigned int draws() const { return matches - wins - losses; }
+    };
+
+    // Overall record of each AI, from any seat
+    std::vector<Record> records(std::size_t playerCount, const std::vector<Match>& matches, const std::vector<MatchResult>& results) {
+        std::vector<Record> records(playerCount);
+        for (std::size_t i = 0; i < matches.size(); ++i) {
+            const auto& seats = matches[i].seats;
+            auto winner = static_cast<std::size_t>(results[i].winner);
+            for (std::size_t p = 0; p < playerCount; ++p) {
+                if (std::find(seats.begin(), seats.end(), p) == seats.end()) {
+                    continue;
+                }
+                auto& record = records[p];
+                record.matches++;
+                if (winner > 0 && seats[winner - 1] == p) {
+                    record.wins++;
+                } else if (winner > 0) {
+                    record.losses++;
+                }
+            }
+        }
+        return records;
+    }
+
+    const char* winnerName(Components::Faction winner) {
+        switch (winner) {
+            case Components::Faction::PLAYER_1: return "first";
+            case Components::Faction::PLAYER_2: return "second";
+            default: return "none";
+        }
+    }
+
+    void writeJson(std::ostream& out, const Options& options, const std::vector<Player>& players, const std::vector<Match>& matches,
+                   const std::vector<MatchResult>& results, const std::vector<Tally>& pairings, double wallSeconds) {
+        unsigned long totalTicks = 0;
+        for (const auto& result : results) {
+            totalTicks += result.ticks;
+        }
+
+        out << "{\n  \"settings\": {\"players\": " << options.players
+            << ", \"matches_per_side\": " << options.matches
+            << ", \"seed\": " << options.seed
+            << ", \"ticks\": " << options.ticks
+            << ", \"tick_rate\": " << options.tickRate
+            << ", \"threads\": " << options.threads << "},\n";
+        out << "  \"totals\": {\"matches\": " << matches.size()
+            << ", \"seconds\": " << wallSeconds
+            << ", \"matches_per_hour\": " << ratio(matches.size() * 3600.0, wallSeconds)
+            << ", \"ticks_per_second\": " << ratio(totalTicks, wallSeconds) << "},\n";
+
+        out << "  \"players\": [\n";
+        auto playerRecords = records(players.size(), matches, results);
+        for (std::size_t p = 0; p < players.size(); ++p) {
+            const auto& record = playerRecords[p];
+            out << "    {\"name\": \"" << players[p].name << "\""
+                << ", \"matches\": " << record.matches
+                << ", \"wins\": " << record.wins
+                << ", \"losses\": " << record.losses
+                << ", \"draws\": " << record.draws()
+                << ", \"win_rate\": " << ratio(record.wins, record.matches)
+                << "}" << (p + 1 < players.size() ? "," : "") << "\n";
+        }
+        out << "  ],\n";
+
+        out << "  \"pairings\": [\n";
+        bool firstRow = true;
+        for (std::size_t a = 0; a < players.size(); ++a) {
+            for (std::size_t b = 0; b < players.size(); ++b) {
+                const auto& tally = pairings[a * players.size() + b];
+                if (tally.matches == 0) {
+                    continue;
+                }
+                out << (firstRow ? "" : ",\n");
+                firstRow = false;
+                out << "    {\"first\": \"" << players[a].name << "\""
+                    << ", \"second\": \"" << players[b].name << "\""
+                    << ", \"matches\": " << tally.matches
+                    << ", \"first_wins\": " << tally.firstWins
+                    << ", \"second_wins\": " << tally.secondWins
+                    << ", \"draws\": " << tally.draws()
+                    << ", \"first_win_rate\": " << ratio(tally.firstWins, tally.matches)
+                    << ", \"mean_ticks\": " << ratio(tally.ticks, tally.matches)
+                    << ", \"ticks_per_second\": " << ratio(tally.ticks, tally.seconds)
+                    << "}";
+            }
+        }
+        out << "\n  ],\n";
+
+        // Two players: winner is first, second or none. Free-for-all: the winning player number, 0 for none
+        out << "  \"matches\": [\n";
+        for (std::size_t i = 0; i < matches.size(); ++i) {
+            const auto& seats = matches[i].seats;
+            out << "    {";
+            if (seats.size() == 2) {
+                out << "\"first\": \"" << players[seats[0]].name << "\""
+                    << ", \"second\": \"" << players[seats[1]].name << "\""
+                    << ", \"seed\": " << matches[i].seed
+                    << ", \"winner\": \"" << winnerName(results[i].winner) << "\"";
+            } else {
+                out << "\"players\": [";
+                for (std::size_t seat = 0; seat < seats.size(); ++seat) {
+                    out << (seat ? ", " : "") << "\"" << players[seats[seat]].name << "\"";
+                }
+                out << "], \"seed\": " << matches[i].seed
+                    << ", \"winner\": " << static_cast<unsigned int>(results[i].winner);
+            }
+            out << ", \"ticks\": " << results[i].ticks
+                << ", \"ticks_per_second\": " << ratio(results[i].ticks, results[i].seconds)
+                << "}" << (i + 1 < matches.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+
+    void writeRecordsCsv(std::ostream& out, const std::vector<Player>& players, const std::vector<Match>& matches, const std::vector<MatchResult>& results) {
+        out << "name,matches,wins,losses,draws,win_rate\n";
+        auto playerRecords = records(players.size(), matches, results);
+        for (std::size_t p = 0; p < players.size(); ++p) {
+            const auto& record = playerRecords[p];
+            out << players[p].name
+                << "," << record.matches
+                << "," << record.wins
+                << "," << record.losses
+                << "," << record.draws()
+                << "," << ratio(record.wins, record.matches) << "\n";
+        }
+    }
+
+    void writeCsv(std::ostream& out, const std::vector<Player>& players, const std::vector<Tally>& pairings) {
+        out << "first,second,matches,first_wins,second_wins,draws,first_win_rate,mean_ticks,ticks_per_second\n";
+        for (std::size_t a = 0; a < players.size(); ++a) {
+            for (std::size_t b = 0; b < players.size(); ++b) {
+                const auto& tally = pairings[a * players.size() + b];
+                if (tally.matches == 0) {
+                    continue;
+                }
+                out << players[a].name << "," << players[b].name
+                    << "," << tally.matches
+                    << "," << tally.firstWins
+                    << "," << tally.secondWins
+                    << "," << tally.draws()
+                    << "," << ratio(tally.firstWins, tally.matches)
+                    << "," << ratio(tally.ticks, tally.matches)
+                    << "," << ratio(tally.ticks, tally.seconds) << "\n";
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // Keep stdout clean for the report
+    logger::Log::stream = &std::cerr;
+
+    Tournament::Options options;
+    const auto usage = [&]() {
+        log_err << "Usage: " << argv[0] << " [--ai Easy,Medium,Hard,Impossible] [--players N] [--matches N] [--seed S] [--ticks N]"
+                << " [--tick-rate HZ] [--threads N] [--format json|csv]";
+    };
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        try {
+            if (arg == "--ai" && i + 1 < argc) {
+                options.ai = Tournament::split(argv[++i], ',');
+            } else if (arg == "--players" && i + 1 < argc) {
+                options.players = static_cast<unsigned int>(std::stoul(argv[++i]));
+            } else if (arg == "--matches" && i + 1 < argc) {
+                options.matches = static_cast<unsigned int>(std::stoul(argv[++i]));
+            } else if (arg == "--seed" && i + 1 < argc) {
+                options.seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+            } else if (arg == "--ticks" && i + 1 < argc) {
+                options.ticks = std::stoul(argv[++i]);
+            } else if (arg == "--tick-rate" && i + 1 < argc) {
+                options.tickRate = std::max(1u, static_cast<unsigned int>(std::stoul(argv[++i])));
+            } else if (arg == "--threads" && i + 1 < argc) {
+                options.threads = std::max(1u, static_cast<unsigned int>(std::stoul(argv[++i])));
+            } else if (arg == "--format" && i + 1 < argc) {
+                options.csv = std::string(argv[++i]) == "csv";
+            } else {
+                usage();
+                return 1;
+            }
+        } catch (const std::exception&) {
+            // Not a number, or out of range
+            log_err << "Invalid value for " << arg << ": " << argv[i];
+            usage();
+            return 1;
+        }
+    }
+
+    std::vector<Tournament::Player> players(options.ai.size());
+    for (std::size_t i = 0; i < options.ai.size(); ++i) {
+        if (!Tournament::parsePlayer(options.ai[i], players[i])) {
+            return 1;
+        }
+    }
+    if (players.size() < 2) {
+        log_err << "A tournament needs at least two AIs";
+        return 1;
+    }
+    if (options.players < 2 || options.players > Components::MAX_PLAYERS) {
+        log_err << "Matches are for 2 to " << Components::MAX_PLAYERS << " players";
+        return 1;
+    }
+
+    std::vector<Tournament::Match> matches;
+    if (options.players == 2) {
+        // Both sides of every pairing on the same maps
+        for (std::size_t a = 0; a < players.size(); ++a) {
+            for (std::size_t b = 0; b < players.size(); ++b) {
+                if (a == b) {
+                    continue;
+                }
+                for (unsigned int m = 0; m < options.matches; ++m) {
+                    matches.push_back({{a, b}, options.seed + m});
+                }
+            }
+        }
+    } else {
+        // Free-for-all: each rotation moves every AI one seat on, so all of them start everywhere
+        for (std::size_t rotation = 0; rotation < players.size(); ++rotation) {
+            for (unsigned int m = 0; m < options.matches; ++m) {
+                Tournament::Match match{{}, options.seed + m};
+                for (std::size_t seat = 0; seat < options.players; ++seat) {
+                    match.seats.push_back((rotation + seat) % players.size());
+                }
+                matches.push_back(match);
+            }
+        }
+    }
+
+    log_info << "Playing " << matches.size() << " matches between " << players.size() << " AIs on " << options.threads << " threads";
+
+    // Per-simulation setup logs would drown the report
+    auto reportingLevel = logger::Log::ReportingLevel;
+    logger::Log::ReportingLevel = logger::Level::kError;
+    auto start = std::chrono::steady_clock::now();
+    auto results = Tournament::playAll(matches, players, options);
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    logger::Log::ReportingLevel = reportingLevel;
+
+    // Head to head only
+    std::vector<Tournament::Tally> pairings(players.size() * players.size());
+    for (std::size_t i = 0; i < matches.size() && options.players == 2; ++i) {
+        auto& tally = pairings[matches[i].seats[0] * players.size() + matches[i].seats[1]];
+        tally.matches++;
+        tally.firstWins += results[i].winner == Components::Faction::PLAYER_1;
+        tally.secondWins += results[i].winner == Components::Faction::PLAYER_2;
+        tally.ticks += results[i].ticks;
+        tally.seconds += results[i].seconds;
+    }
+
+    log_info << "Played " << matches.size() << " matches in " << wallSeconds << " s ("
+             << Tournament::ratio(matches.size() * 3600.0, wallSeconds) << " matches/hour)";
+
+    if (options.csv && options.players > 2) {
+        Tournament::writeRecordsCsv(std::cout, players, matches, results);
+    } else if (options.csv) {
+        Tournament::writeCsv(std::cout, players, pairings);
+    } else {
+        Tournament::writeJson(std::cout, options, players, matches, results, pairings, wallSeconds);
+    }
+    return 0;
+}
@@ -5,10 +5,22 @@
 #include <unordered_set>
 #include <map>
 #include <vector>
-#include <set>
+#include <string>
+#include <cstdint>
+#include <array>
+#include <SFML/System/Vector2.hpp>
+#include <entt/entity/registry.hpp>
 
 using EntityID = entt::entity;
 
+#include "Components/FactionComponent.hpp"
+#include "Config.hpp"
+
+namespace Game {
+    class FactionSummary;
+    class NeighbourTable;
+}
+
 namespace Components {
 
     namespace AI{
@@ -17,75 +29,128 @@ namespace Components {
                 EntityID target;
                 float distance = 0.f;
                 float cost = 0.f;
+                Faction targetFaction = Faction::NEUTRAL;  // When planned; the order is stale once this changes
 
-                AttackPair(EntityID source, EntityID target, float dist, float cost) : source(source), target(target), distance(dist), cost(cost) {}
-            };
-
-            // Comparator for Cost
-            struct ComparatorPairByCost {
-                bool operator()(const AttackPair& a, const AttackPair& b) const {
-                    if (a.cost != b.cost) {
-                        return a.cost < b.cost;
-                    }
-                    return std::tie(a.source, a.target) < std::tie(b.source, b.target);
-                }
-            };
-
-            // Comparator for Distance
-            struct ComparatorPairByDistance {
-                bool operator()(const AttackPair& a, const AttackPair& b) const {
-                    if (a.distance != b.distance) {
-                        return a.distance < b.distance;
-                    }
-                    return std::tie(a.source, a.target) < std::tie(b.source, b.target);
-                }
+                AttackPair(EntityID source, EntityID target, float dist, float cost, Faction targetFaction = Faction::NEUTRAL)
+                    : source(source), target(target), distance(dist), cost(cost), targetFaction(targetFaction) {}
             };
     }
     
+    // What every AI sees, swept once by PerceptionSystem for all AIs deciding on a tick.
+    // Per faction aggregates are indexed by faction, per garrison state by neighbour table row.
     struct AIPerception {
-        unsigned int aiTotalDrones = 0;
-        unsigned int aiTotalEnergy = 0;
-        float aiDroneProductionRate = 0.f;
-        std::set<AI::AttackPair, AI::ComparatorPairByDistance> aiAttackOrders;
-
-        unsigned int playerTotalDrones = 0;
-        unsigned int playerTotalEnergy = 0;
-        float playerDroneProductionRate = 0.f;
-        std::set<AI::AttackPair, AI::ComparatorPairByDistance> playerAttackOrders;
-
-        sf::Vector2f aiCentralPosition;
-
-        std::unordered_map<EntityID, unsigned int> garissonByDroneCount;
-        std::unordered_map<EntityID, std::map<float, EntityID>> garissonsByDistance;
-        std::unordered_set<EntityID> playerGarissons;
-        std::unordered_set<EntityID> aiGarissons;
+        using FactionMask = std::uint16_t;  // Bit per faction
+        static_assert(FACTION_COUNT <= 16, "FactionMask holds a bit per faction");
+
+        std::array<unsigned int, FACTION_COUNT> totalDrones{};
+        std::array<unsigned int, FACTION_COUNT> totalEnergy{};
+        std::array<float, FACTION_COUNT> droneProductionRate{};
+
+        // Cheapest target base cost and slowest regeneration of any garrison not held by the faction
+        std::array<float, FACTION_COUNT> cheapestBaseCost{};
+        std::array<float, FACTION_COUNT> slowestRegenRate{};
+
+        // Per garrison
+        std::vector<Faction> factions;
+        std::vector<float> baseCosts;           // Drones stationed plus current shield
+        std::vector<float> regenRates;
+        std::vector<std::uint8_t> kinds;        // AIPlan::TargetKind
+        std::vector<FactionMask> ordersFrom;    // Factions with an attack order standing from / against it
+        std::vector<FactionMask> ordersAgainst;
+
+        // Kept current by GameEntityManager, refreshed by the sweep
+        const Game::FactionSummary* summary = nullptr;
+        const Game::NeighbourTable* neighbours = nullptr;
+
+        static FactionMask bit(Faction faction) { return static_cast<FactionMask>(1u << static_cast<unsigned int>(faction)); }
+    };
 
-        void reset(){
-            aiTotalDrones = 0;
-            aiTotalEnergy = 0;
-            aiDroneProductionRate = 0.f;
+    // AI garrisons an attack can start from, with how far down their neighbour row planning has got
+    struct AIOrigins {
+        std::vector<EntityID> ids;
+        std::vector<std::uint32_t> rows;        // NeighbourTable rows
+        std::vector<float> drones;
+        std::vector<std::uint32_t> cursors;     // Next neighbour to consider
+        std::vector<std::uint32_t> ends;        // Past the last neighbour in reach
+
+        std::size_t size() const { return ids.size(); }
+
+        void push_back(EntityID id, std::uint32_t row, float droneCount) {
+            ids.push_back(id);
+            rows.push_back(row);
+            drones.push_back(droneCount);
+            cursors.push_back(0);
+            ends.push_back(0);
+        }
 
-            playerTotalDrones = 0;
-            playerTotalEnergy = 0;
-            playerDroneProductionRate = 0.f;
+        void clear() {
+            ids.clear();
+            rows.clear();
+            drones.clear();
+            cursors.clear();
+            ends.clear();
+        }
+    };
 
-            aiCentralPosition = {0.f, 0.f};
+    // One decision: a snapshot of the world taken by PerceptionSystem, planning buffers, and the
+    // orders planned. Planning reads nothing else, so it can run off the simulation thread.
+    // reset() clears the buffers but keeps their capacity, so a decision does not allocate once
+    // the first few have run.
+    struct AIPlan {
+        enum TargetKind : std::uint8_t { OTHER = 0, POWER_PLANT = 1, FACTORY = 2 };
 
-            garissonByDroneCount.clear();
-            garissonsByDistance.clear();
+        // How far PlanSystem has got with the decision, in order
+        enum class Stage : std::uint8_t { START, REACH, STRATEGY, FALLBACK, CONSOLIDATE, DONE };
 
-            playerGarissons.clear();
-            aiGarissons.clear();
+        // Garrisons never move, and AISystem does not let the table be rebuilt while any decision
+        // is being planned
+        const Game::NeighbourTable* neighbours = nullptr;
 
-            aiAttackOrders.clear();
-            playerAttackOrders.clear();
-        }
-    };
+        Faction faction = Faction::PLAYER_2;    // Planning for
 
-    struct AIPlan {
-        std::string currentAction;
+        // Difficulty and totals when the snapshot was taken
+        std::size_t maxOrders = 0;
+        float maxDistance = 0.f;
+        unsigned int aiTotalDrones = 0;
+        unsigned int aiTotalEnergy = 0;
+        std::size_t stepsPerTick = 0;           // 0: planned at once
+        float deadline = 0.f;                   // Seconds after submission the orders are due
+
+        // Cheapest target base cost and slowest regeneration of any garrison not held by the faction
+        float cheapestBaseCost = 0.f;
+        float slowestRegenRate = 0.f;
+
+        // Per garrison, indexed by NeighbourTable row
+        std::vector<Faction> factions;
+        std::vector<float> baseCosts;           // Drones stationed plus current shield
+        std::vector<float> regenRates;
+        std::vector<std::uint8_t> kinds;
+        std::vector<std::uint8_t> busySources;  // Attack order standing or issued this decision
+        std::vector<std::uint8_t> busyTargets;
+
+        AIOrigins origins;
+        std::vector<std::uint32_t> heap;        // Origins by their next neighbour, nearest on top
+
+        // Planning progress, kept between slices
+        Stage stage = Stage::START;
+        std::uint32_t cursor = 0;               // Next origin of the current stage
+        std::uint8_t wantedKind = OTHER;
+        EntityID closestSource{entt::null};     // Origin closest to a target, where to consolidate
+        float closestDistance = 0.f;
+        float closestCost = 0.f;
+
+        std::vector<Components::AI::AttackPair> orders;
 
         void reset(){
+            origins.clear();
+            heap.clear();
+            orders.clear();
+            stage = Stage::START;
+            cursor = 0;
+            wantedKind = OTHER;
+            closestSource = entt::null;
+            closestDistance = 0.f;
+            closestCost = 0.f;
         }
     };
 
@@ -105,16 +170,19 @@ namespace Components {
         }
     };
 
+    // One per AI player, playing faction at the given difficulty
     struct AIComponent {
+        Faction faction = Faction::PLAYER_2;
+        Config::Difficulty difficulty;
+        float sinceDecision = 0.f;      // Seconds, a decision is due once past the decision interval
         EntityID highlightedEntityID;
-        AIPerception perception;
-        AIPlan plan;
         AIExecute execute;
         AIDebug debug;
 
+        AIComponent(Faction faction = Faction::PLAYER_2, Config::Difficulty difficulty = {})
+            : faction(faction), difficulty(difficulty) {}
+
         void reset() { 
-            perception.reset();
-            plan.reset();
             execute.reset();
             debug.reset();
         }
@@ -5,8 +5,8 @@
 namespace Components {
 
     struct AttackOrderComponent {
-        EntityID origin;
-        EntityID target;
+        EntityID origin{entt::null};
+        EntityID target{entt::null}; // Null until a first order is given
         bool isActivated;
         Faction faction = Faction::NEUTRAL; // Who placed this attack order
 
@@ -1,16 +1,15 @@
 #ifndef DRONE_COMPONENT_HPP
 #define DRONE_COMPONENT_HPP
 
-#include <string>
-#include "Utils/Logger.hpp"
-
 namespace Components {
+    // Plain data so spawning a drone never allocates: no name, shape or label,
+    // drones are drawn from Transform + Faction.
     struct DroneComponent {
-        std::string droneName;
+        unsigned int index = 0; // Position within its launch
 
-        DroneComponent(const std::string& droneName) : droneName(droneName) {}
-        ~DroneComponent(){};
+        DroneComponent() = default;
+        DroneComponent(unsigned int index) : index(index) {}
     };
 }
 
-#endif
\ No newline at end of file
+#endif
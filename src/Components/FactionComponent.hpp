@@ -1,6 +1,7 @@
 #ifndef FACTION_COMPONENT_HPP
 #define FACTION_COMPONENT_HPP
 
+#include <cstddef>
 #include <string> 
 
 namespace Components {
@@ -8,9 +9,18 @@ namespace Components {
         NEUTRAL = 0,
         PLAYER_1 = 1,
         PLAYER_2 = 2,
-        PLAYER_3 = 3
+        PLAYER_3 = 3,
+        PLAYER_4 = 4,
+        PLAYER_5 = 5,
+        PLAYER_6 = 6,
+        PLAYER_7 = 7,
+        PLAYER_8 = 8
     };
 
+    // For per-faction arrays indexed by the enum value
+    constexpr std::size_t FACTION_COUNT = 9;
+    constexpr unsigned int MAX_PLAYERS = FACTION_COUNT - 1;
+
     struct FactionComponent {
         Faction faction = Faction::NEUTRAL;
         FactionComponent(Faction id = Faction::NEUTRAL) : faction(id) {}
@@ -0,0 +1,35 @@
+#ifndef FLEET_COMPONENT_HPP
+#define FLEET_COMPONENT_HPP
+
+#include <cstdint>
+#include <SFML/System/Vector2.hpp>
+
+namespace Components {
+
+    // Drones launched together from one garrison at one target.
+    // Individual drones are not entities, their positions are derived from the fleet when drawn.
+    // Offsets shrink to zero as the fleet's flight progresses.
+    struct FleetComponent {
+        unsigned int droneCount = 0;
+        float spread = 0.f;         // Max offset of a drone from the fleet center at launch
+        std::uint32_t seed = 0;     // Picks the spread pattern
+
+        FleetComponent() = default;
+        FleetComponent(unsigned int droneCount, float spread, std::uint32_t seed)
+            : droneCount(droneCount), spread(spread), seed(seed) {}
+
+        // Offset of a drone from the fleet center at launch, in [-spread, spread] on both axes
+        sf::Vector2f getDroneOffset(unsigned int index) const {
+            std::uint32_t h = seed ^ (index * 0x9E3779B9u);
+            h ^= h >> 16; h *= 0x7FEB352Du;
+            h ^= h >> 15; h *= 0x846CA68Bu;
+            h ^= h >> 16;
+
+            float x = (h & 0xFFFFu) / 65535.f * 2.f - 1.f;
+            float y = (h >> 16) / 65535.f * 2.f - 1.f;
+            return {x * spread, y * spread};
+        }
+    };
+}
+
+#endif // FLEET_COMPONENT_HPP
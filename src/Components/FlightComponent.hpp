@@ -0,0 +1,36 @@
+#ifndef FLIGHT_COMPONENT_HPP
+#define FLIGHT_COMPONENT_HPP
+
+#include <algorithm>
+#include <SFML/System/Vector2.hpp>
+
+namespace Components {
+
+    // Straight flight at constant speed, position is a function of time.
+    // Nothing integrates it per tick: arrival is an event scheduled at launch.
+    struct FlightComponent {
+        sf::Vector2f launchPosition;
+        sf::Vector2f targetPosition;
+        double launchTime = 0.0;    // Simulation seconds
+        double arrivalTime = 0.0;
+        float rotation = 0.f;       // Heading in degrees, triangle tip forward
+
+        FlightComponent() = default;
+        FlightComponent(sf::Vector2f launchPosition, sf::Vector2f targetPosition, double launchTime, double arrivalTime, float rotation)
+            : launchPosition(launchPosition), targetPosition(targetPosition), launchTime(launchTime), arrivalTime(arrivalTime), rotation(rotation) {}
+
+        // 0 at launch, 1 on arrival
+        float getProgress(double time) const {
+            if (arrivalTime <= launchTime) {
+                return 1.f;
+            }
+            return static_cast<float>(std::clamp((time - launchTime) / (arrivalTime - launchTime), 0.0, 1.0));
+        }
+
+        sf::Vector2f getPosition(double time) const {
+            return launchPosition + (targetPosition - launchPosition) * getProgress(time);
+        }
+    };
+}
+
+#endif // FLIGHT_COMPONENT_HPP
@@ -11,16 +11,12 @@ namespace Components {
         Faction winner = Faction::NEUTRAL;
         bool isGameOver = false;
 
-        GameStateComponent(unsigned int playerCount) {
-            if(playerCount == 1){
-                playerDrones[Faction::PLAYER_1] = 0;
-                playerEnergy[Faction::PLAYER_1] = 0;
-            }
-            else if(playerCount == 2){
-                playerDrones[Faction::PLAYER_1] = 0;
-                playerDrones[Faction::PLAYER_2] = 0;
-                playerEnergy[Faction::PLAYER_1] = 0;
-                playerEnergy[Faction::PLAYER_2] = 0;
+        unsigned int playerCount;       // Factions PLAYER_1 up to this one play
+
+        GameStateComponent(unsigned int playerCount) : playerCount(playerCount) {
+            for(unsigned int player = 1; player <= playerCount; ++player){
+                playerDrones[static_cast<Faction>(player)] = 0;
+                playerEnergy[static_cast<Faction>(player)] = 0;
             }
         }
 
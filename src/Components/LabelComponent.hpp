@@ -1,36 +1,38 @@
 #ifndef TEXT_COMPONENT_HPP
 #define TEXT_COMPONENT_HPP
 
+#include <cstdint>
+#include <string>
 #include <SFML/Graphics.hpp>
 
 // The text will be rendered relative to the parent
-// This is not part of GUI
+// This is not part of GUI. Only the strings live here; the sf::Text objects
+// are owned by the window thread (see RenderCache).
 namespace Components {
     struct LabelComponent {
-        sf::Text text;
+        std::string text;
         sf::Vector2f offset; // Relative position to the parent
 
-        sf::Text text2;
+        std::string count; // Drones stationed, centered on the parent
+
+        unsigned int fontSize = 18;
+        sf::Color color = sf::Color::White;
+
+        // Text is re-formatted only when dirty, set by GameEntityManager when the
+        // garrison, factory or power plant of the entity is patched
+        bool dirty = true;
+        std::uint32_t version = 0; // Bumped whenever the strings change
 
         LabelComponent() = default;
 
-        LabelComponent(const std::string& label, const sf::Font& font, unsigned int fontSize, const sf::Color& color, sf::Vector2f offset = {0.f, 0.f}) {
-            text.setFont(font);
-            text.setString(label);
-            text.setCharacterSize(fontSize);
-            text.setFillColor(color);
-            this->offset = offset;
-
-            text2.setFont(font);
-            text2.setScale(1.f, 1.f);
-            text2.setCharacterSize(fontSize);
-            text2.setFillColor(color);
-        }
+        LabelComponent(const std::string& label, unsigned int fontSize, const sf::Color& color, sf::Vector2f offset = {0.f, 0.f})
+            : text(label), offset(offset), fontSize(fontSize), color(color) {}
 
         void setText(const std::string& label) {
-            text.setString(label);
+            text = label;
+            version++;
         }
     };
 }
 
-#endif // TEXT_COMPONENT_HPP
\ No newline at end of file
+#endif // TEXT_COMPONENT_HPP
@@ -4,6 +4,8 @@
 #include <SFML/Graphics.hpp>
 
 namespace Components {
+    // Movement to a target is simulated in Game::MovementBuffers, which follows this component
+    // through registry signals: write it through GameEntityManager::patchComponent.
     struct MoveComponent {
         float speed;
         float angularVelocity; // Rotation speed (degrees per second)
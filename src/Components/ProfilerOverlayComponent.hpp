@@ -0,0 +1,15 @@
+#ifndef PROFILER_OVERLAY_COMPONENT_HPP
+#define PROFILER_OVERLAY_COMPONENT_HPP
+
+#include <TGUI/TGUI.hpp>
+
+namespace Components {
+
+    // Widgets of the profiler overlay, created in the owner's gui on first use
+    struct ProfilerOverlayComponent {
+        tgui::Panel::Ptr panel = nullptr;
+        tgui::Label::Ptr label = nullptr;
+    };
+}
+
+#endif // PROFILER_OVERLAY_COMPONENT_HPP
@@ -2,34 +2,31 @@
 #define SHAPE_COMPONENT_HPP
 
 #include <SFML/Graphics.hpp>
-#include <memory>
 
 namespace Components {
 
+    // Archetype geometry, shared by all entities of the same type (see Utils::getUnitGeometry)
+    enum class ShapeType {
+        Square,
+        Circle,
+        Triangle
+    };
+
     struct ShapeComponent {
-        std::shared_ptr<sf::Shape> shape; // Polymorphic shared pointer to any sf::Shape
+        ShapeType type = ShapeType::Square;
+        float size = 0.f; // Half extent: half the side of a square, radius of a circle
 
         // Default Constructor
         ShapeComponent() = default;
 
-        // Constructor with shape
-        ShapeComponent(std::shared_ptr<sf::Shape> shapePtr)
-            : shape(shapePtr) {}
-
-        // Utility to set fill color
-        void setFillColor(const sf::Color& color) {
-            if (shape) {
-                shape->setFillColor(color);
-            }
-        }
+        ShapeComponent(ShapeType type, float size)
+            : type(type), size(size) {}
 
-        // Utility to set outline
-        void setOutlineColor(const sf::Color& color) {
-            if (shape) {
-                shape->setOutlineColor(color);
-            }
+        // Axis aligned bounds when centered at position
+        sf::FloatRect getBounds(sf::Vector2f position) const {
+            return sf::FloatRect(position.x - size, position.y - size, size * 2.f, size * 2.f);
         }
     };
 }
 
-#endif // SHAPE_COMPONENT_HPP
\ No newline at end of file
+#endif // SHAPE_COMPONENT_HPP
@@ -8,6 +8,7 @@ namespace Components {
     
     struct TransformComponent {
         sf::Transformable transform;
+        sf::Vector2f previousPosition; // Position at the previous simulation tick
 
         TransformComponent() = default;
 
@@ -15,6 +16,18 @@ namespace Components {
             transform.setPosition(pos);
             transform.setRotation(rot);
             transform.setScale(scl);
+            previousPosition = pos;
+        }
+
+        // Place without interpolating from the old position (e.g. spawning).
+        // Outside MovementSystem, through GameEntityManager::patchComponent so the spatial grid follows.
+        void teleport(const sf::Vector2f& pos) {
+            transform.setPosition(pos);
+            previousPosition = pos;
+        }
+
+        sf::Vector2f getInterpolatedPosition(float alpha) const {
+            return previousPosition + (transform.getPosition() - previousPosition) * alpha;
         }
 
         sf::Vector2f getPosition() const { return transform.getPosition(); }
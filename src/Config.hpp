@@ -1,6 +1,8 @@
 #ifndef CONFIG_HPP
 #define CONFIG_HPP
 
+#include <string>
+
 namespace Config {
     const unsigned int SCREEN_WIDTH = 1920; 
     const unsigned int SCREEN_HEIGHT = 1080;
@@ -16,15 +18,52 @@ namespace Config {
 
     // GUI consts
     constexpr float GUI_TEXT_SIZE = 18.f;
+    const float HUD_UPDATE_INTERVAL_SEC = 0.1f; // HUD and labels refresh at 10 Hz
 
     // Game consts
     const float DRONE_SPEED = 100.f;
+    const float GAME_STATE_CHECK_INTERVAL_SEC = 5.f;
+
+    // Fixed simulation timestep
+    const unsigned int SIMULATION_TICK_HZ = 60;
+    const unsigned int SIMULATION_MAX_CATCHUP_STEPS = 5; // Per wake-up of the simulation thread
     
-    // Game Difficulty
+    // AI Difficulty, one per AI player; defaults to Medium
     struct Difficulty {
-        inline static float AI_DECISION_INTERVAL_SEC = 5.f;
-        inline static unsigned int AI_MAX_EXECUTIONS_PER_TURN = 10;
-        inline static float AI_MAX_DISTANCE_TO_ATTACK = 500.f;
+        float decisionIntervalSec = 5.f;
+        unsigned int maxExecutionsPerTurn = 10;
+        float maxDistanceToAttack = 500.f;
+        // Planning work per tick, one origin garrison or one candidate target per step.
+        // 0 plans a decision at once; otherwise it is sliced over the ticks up to the next decision.
+        unsigned int planStepsPerTick = 0;
+
+        // Presets offered in the HUD; false if the name is unknown
+        bool setLevel(const std::string& level) {
+            if(level == "Easy"){
+                decisionIntervalSec = 10.f;
+                maxExecutionsPerTurn = 2;
+                maxDistanceToAttack = 300.f;
+                planStepsPerTick = 0;
+            }else if(level == "Medium"){
+                decisionIntervalSec = 5.f;
+                maxExecutionsPerTurn = 10;
+                maxDistanceToAttack = 500.f;
+                planStepsPerTick = 0;
+            }else if(level == "Hard"){
+                decisionIntervalSec = 3.f;
+                maxExecutionsPerTurn = 15;
+                maxDistanceToAttack = 750.f;
+                planStepsPerTick = 64;
+            }else if(level == "Impossible"){
+                decisionIntervalSec = 1.f;
+                maxExecutionsPerTurn = 30;
+                maxDistanceToAttack = 2000.f;
+                planStepsPerTick = 128;
+            }else{
+                return false;
+            }
+            return true;
+        }
     };
 
     // Debug Symbols
@@ -0,0 +1,108 @@
+#include "AIPlanner.hpp"
+
+#include <limits>
+
+#include "Utils/Logger.hpp"
+
+namespace Game {
+
+    AIPlanner::AIPlanner(PlanFunction planFunction, bool background)
+        : planFunction(planFunction), background(background)
+    {
+        if (background) {
+            worker = std::thread(&AIPlanner::run, this);
+        }
+    }
+
+    AIPlanner::~AIPlanner()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    void AIPlanner::submit()
+    {
+        if (isBusy()) {
+            log_err << "AI decision submitted while the previous one is in flight";
+            return;
+        }
+
+        if (plan.stepsPerTick > 0) {
+            elapsed = 0.f;
+            state.store(State::SLICING, std::memory_order_release);
+            return;
+        }
+
+        if (!background) {
+            PROFILE_SCOPE("AI::Plan");
+            planFunction(plan, std::numeric_limits<std::size_t>::max());
+            state.store(State::DONE, std::memory_order_release);
+            return;
+        }
+
+        {
+            // The worker records into the submitting thread's profiler
+            std::lock_guard<std::mutex> lock(mutex);
+            profiler = Utils::Profiler::getCurrent();
+            state.store(State::PLANNING, std::memory_order_release);
+        }
+        wake.notify_one();
+    }
+
+    void AIPlanner::advance(float dt)
+    {
+        if (state.load(std::memory_order_acquire) != State::SLICING) {
+            return;
+        }
+
+        // Past the deadline the orders planned so far are carried out, the rest is dropped
+        elapsed += dt;
+        bool complete;
+        {
+            PROFILE_SCOPE("AI::Plan");
+            complete = planFunction(plan, plan.stepsPerTick);
+        }
+        if (complete || elapsed >= plan.deadline) {
+            state.store(State::DONE, std::memory_order_release);
+        }
+    }
+
+    bool AIPlanner::takeOrders(std::vector<Components::AI::AttackPair>& orders)
+    {
+        if (state.load(std::memory_order_acquire) != State::DONE) {
+            return false;
+        }
+        orders.swap(plan.orders);
+        plan.orders.clear();
+        state.store(State::IDLE, std::memory_order_release);
+        return true;
+    }
+
+    void AIPlanner::run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [this]() { return stopping || state.load(std::memory_order_acquire) == State::PLANNING; });
+            if (stopping) {
+                break;
+            }
+            Utils::Profiler::setCurrent(profiler);
+            lock.unlock();
+
+            {
+                PROFILE_SCOPE("AI::Plan");
+                planFunction(plan, std::numeric_limits<std::size_t>::max());
+            }
+
+            lock.lock();
+            state.store(State::DONE, std::memory_order_release);
+        }
+        Utils::Profiler::setCurrent(nullptr);
+    }
+}
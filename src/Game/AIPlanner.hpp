@@ -0,0 +1,72 @@
+#ifndef AI_PLANNER_HPP
+#define AI_PLANNER_HPP
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Components/AIComponent.hpp"
+#include "Utils/Profiler.hpp"
+
+namespace Game {
+
+    // Plans AI decisions off the simulation thread. The simulation fills the request with a
+    // snapshot, submits it, and picks the orders up on a later tick; it never waits for them.
+    // One decision is in flight at a time. Without a background thread (headless matches)
+    // the plan is made on submit, so results do not depend on thread timing.
+    // A request with a step budget per tick is instead planned a slice per advance() on the
+    // simulation thread, and its orders are due once planned or once its deadline has passed.
+    class AIPlanner {
+    public:
+        // Plans at most steps units of work, true once the decision is complete
+        using PlanFunction = bool (*)(Components::AIPlan& plan, std::size_t steps);
+
+    private:
+        enum class State { IDLE, PLANNING, SLICING, DONE };
+
+        PlanFunction planFunction;
+        Components::AIPlan plan;    // Owned by the worker while PLANNING
+        std::atomic<State> state{State::IDLE};
+        Utils::Profiler* profiler = nullptr;
+        float elapsed = 0.f;        // Since a sliced request was submitted
+
+        bool background;
+        bool stopping = false;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::thread worker;
+
+        void run();
+
+    public:
+        AIPlanner(PlanFunction planFunction, bool background);
+        ~AIPlanner();
+
+        // Prevent Copying
+        AIPlanner(const AIPlanner&) = delete;
+        AIPlanner& operator=(const AIPlanner&) = delete;
+
+        // A decision is submitted and its orders not taken yet
+        bool isBusy() const { return state.load(std::memory_order_acquire) != State::IDLE; }
+
+        // Snapshot to fill for the next decision; only while not busy
+        Components::AIPlan& getRequest() { return plan; }
+
+        void submit();
+
+        // Plans the next slice of a sliced request; call once per tick
+        void advance(float dt);
+
+        // Moves the planned orders into orders if the decision is done; false otherwise
+        bool takeOrders(std::vector<Components::AI::AttackPair>& orders);
+    };
+
+    // One per AI, by the faction it plays
+    using AIPlanners = std::array<std::unique_ptr<AIPlanner>, Components::FACTION_COUNT>;
+}
+
+#endif // AI_PLANNER_HPP
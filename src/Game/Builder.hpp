@@ -3,10 +3,11 @@
 
 #include <unordered_map>
 #include <string>
+#include <cmath>
+#include <algorithm>
 
 
 
-#include "Components/DroneComponent.hpp"
 #include "Components/ShieldComponent.hpp"
 #include "Components/FactoryComponent.hpp"
 #include "Components/PowerPlantComponent.hpp"
@@ -17,13 +18,13 @@
 #include "Components/MoveComponent.hpp"
 #include "Components/SelectableComponent.hpp"
 #include "Components/GarissonComponent.hpp"
+#include "Components/FleetComponent.hpp"
+#include "Components/FlightComponent.hpp"
 #include "Utils/Logger.hpp"
-#include "Resources/ResourceManager.hpp"
 #include "Config.hpp"
 
 #include "Game/GameEntityManager.hpp"
 
-#include "Utils/Random.hpp"
 
 namespace Game {
 
@@ -34,17 +35,14 @@ namespace Game {
 
         entityManager.addComponent<Components::FactoryComponent>(factoryID, name, productionRate);
         entityManager.addComponent<Components::TransformComponent>(factoryID, position, 0, sf::Vector2f(1, 1));
-        auto shape = sf::RectangleShape({Config::FACTORY_SIZE, Config::FACTORY_SIZE});
-        sf::Color color{100,100,100};
-        shape.setFillColor(color);
-        shape.setOrigin(shape.getSize().x / 2, shape.getSize().y / 2);
-        entityManager.addComponent<Components::ShapeComponent>(factoryID, std::make_shared<sf::RectangleShape>(shape));
-        entityManager.addComponent<Components::LabelComponent>(factoryID, name, 
-            Resource::ResourceManager::getInstance().getFont(Resource::Paths::FONT_TOXIGENESIS), 
-            18, 
-            sf::Color::White, 
-            sf::Vector2f(Config::FACTORY_SIZE+5, - float(Config::FACTORY_SIZE))
-        );
+        entityManager.addComponent<Components::ShapeComponent>(factoryID, Components::ShapeType::Square, Config::FACTORY_SIZE / 2.f);
+        if (!entityManager.isHeadless()) {
+            entityManager.addComponent<Components::LabelComponent>(factoryID, name, 
+                18, 
+                sf::Color::White, 
+                sf::Vector2f(Config::FACTORY_SIZE+5, - float(Config::FACTORY_SIZE))
+            );
+        }
         entityManager.addComponent<Components::HoverComponent>(factoryID);
         entityManager.addComponent<Components::SelectableComponent>(factoryID);
         entityManager.addComponent<Components::FactionComponent>(factoryID, faction);
@@ -58,17 +56,14 @@ namespace Game {
         EntityID powerPlantID = entityManager.createEntity();
         entityManager.addComponent<Components::PowerPlantComponent>(powerPlantID, name,energyCapacity);
         entityManager.addComponent<Components::TransformComponent>(powerPlantID, position, 0, sf::Vector2f(1, 1));
-        auto shape = sf::CircleShape(Config::POWER_PLANT_RADIUS);
-        sf::Color color{100,100,100};
-        shape.setFillColor(color);
-        shape.setOrigin(Config::POWER_PLANT_RADIUS, Config::POWER_PLANT_RADIUS);
-        entityManager.addComponent<Components::ShapeComponent>(powerPlantID, std::make_shared<sf::CircleShape>(shape));
-        entityManager.addComponent<Components::LabelComponent>(powerPlantID, name, 
-            Resource::ResourceManager::getInstance().getFont(Resource::Paths::FONT_TOXIGENESIS), 
-            18, 
-            sf::Color::White, 
-            sf::Vector2f(Config::POWER_PLANT_RADIUS*2, -2*float(Config::POWER_PLANT_RADIUS))
-        );
+        entityManager.addComponent<Components::ShapeComponent>(powerPlantID, Components::ShapeType::Circle, float(Config::POWER_PLANT_RADIUS));
+        if (!entityManager.isHeadless()) {
+            entityManager.addComponent<Components::LabelComponent>(powerPlantID, name, 
+                18, 
+                sf::Color::White, 
+                sf::Vector2f(Config::POWER_PLANT_RADIUS*2, -2*float(Config::POWER_PLANT_RADIUS))
+            );
+        }
         entityManager.addComponent<Components::HoverComponent>(powerPlantID);
         entityManager.addComponent<Components::SelectableComponent>(powerPlantID );
         entityManager.addComponent<Components::FactionComponent>(powerPlantID, faction);
@@ -80,32 +75,44 @@ namespace Game {
         return powerPlantID;
     }
 
-    EntityID createDrone(GameEntityManager& entityManager, std::string name = "", Components::Faction faction = Components::Faction::NEUTRAL) {
-        EntityID droneID = entityManager.createEntity();
-        
-        entityManager.addComponent<Components::DroneComponent>(droneID, name);
-        entityManager.addComponent<Components::TransformComponent>(droneID, sf::Vector2f(0.f,0.f), 0.f, sf::Vector2f(1, 1));
-        auto shape = std::make_shared<sf::ConvexShape>();
-        shape->setPointCount(3);
-        shape->setOrigin(sf::Vector2f(0.f, 0.f));
-        shape->setPoint(0, sf::Vector2f(0.f, -Config::DRONE_LENGTH));  // Top point
-        shape->setPoint(1, sf::Vector2f(-Config::DRONE_LENGTH, Config::DRONE_LENGTH)); // Bottom-left point
-        shape->setPoint(2, sf::Vector2f(Config::DRONE_LENGTH, Config::DRONE_LENGTH));  // Bottom-right point
-        sf::Color color{100,100,100};
-        shape->setFillColor(color);
-        entityManager.addComponent<Components::ShapeComponent>(droneID, shape);
-        entityManager.addComponent<Components::LabelComponent>(droneID, name, 
-            Resource::ResourceManager::getInstance().getFont(Resource::Paths::FONT_TOXIGENESIS), 
-            18, 
-            sf::Color::White, 
-            sf::Vector2f(Config::DRONE_LENGTH*2, 5)
-        );
-
-        entityManager.addComponent<Components::MoveComponent>(droneID, Config::DRONE_SPEED, 0.f);
-        entityManager.addComponent<Components::FactionComponent>(droneID, faction);
-        entityManager.addComponent<Components::AttackOrderComponent>(droneID);
-
-        return droneID;
+    EntityID createFleet(GameEntityManager& entityManager, Components::Faction faction, EntityID origin, EntityID target, unsigned int droneCount, sf::Vector2f position, sf::Vector2f targetPosition) {
+        EntityID fleetID = entityManager.acquireEntity();
+
+        // Larger launches spread wider around the origin
+        float spread = std::min(25.f + droneCount * 5.f, 75.f);
+        sf::Vector2f direction = targetPosition - position;
+        float distance = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+
+        // Same stopping rule as MovementSystem: close enough counts as arrived
+        float stoppingDistance = std::max(5.0f, Config::DRONE_SPEED * 0.1f);
+        double launchTime = entityManager.getSimulationTime();
+        double arrivalTime = launchTime + std::max(0.f, distance - stoppingDistance) / Config::DRONE_SPEED;
+        float rotation = std::atan2(direction.y, direction.x) * Config::RAD_TO_DEG + 90.f; // Align triangle tip
+
+        entityManager.addComponent<Components::FleetComponent>(fleetID, droneCount, spread, static_cast<std::uint32_t>(entityManager.getRandomEngine()()));
+        entityManager.addComponent<Components::FlightComponent>(fleetID, position, targetPosition, launchTime, arrivalTime, rotation);
+        entityManager.addComponent<Components::FactionComponent>(fleetID, faction);
+        entityManager.addComponent<Components::AttackOrderComponent>(fleetID, origin, target);
+        entityManager.scheduleArrival(arrivalTime, fleetID);
+
+        return fleetID;
+    }
+
+    void destroyFleet(GameEntityManager& entityManager, EntityID fleetID) {
+        entityManager.releaseEntity<
+            Components::FleetComponent,
+            Components::FlightComponent,
+            Components::FactionComponent,
+            Components::AttackOrderComponent>(fleetID);
+    }
+
+    // Same, applied at the next flush. For systems.
+    void destroyFleet(CommandBuffer& commands, EntityID fleetID) {
+        commands.release<
+            Components::FleetComponent,
+            Components::FlightComponent,
+            Components::FactionComponent,
+            Components::AttackOrderComponent>(fleetID);
     }
     
 }
@@ -0,0 +1,226 @@
+#ifndef COMMAND_BUFFER_HPP
+#define COMMAND_BUFFER_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <entt/entity/registry.hpp>
+
+#include "Game/SystemAccess.hpp"
+
+namespace Game {
+
+    class GameEntityManager;
+
+    // Structural changes (create, emplace, remove, release, destroy) recorded by a
+    // system and applied later by GameEntityManager::flushCommands(), so nothing
+    // changes under a view being iterated or a system running on another thread.
+    // One queue per command kind and component type; queues keep their capacity.
+    class CommandBuffer {
+    public:
+        // Flush order: creates first, destroys last. Commands apply by kind, not in record order.
+        enum class Kind { Create, Emplace, Remove, Release, Destroy };
+
+        struct FlushContext {
+            entt::registry& registry;
+            GameEntityManager& manager;
+            std::vector<entt::entity>& entityPool;
+        };
+
+        class Queue {
+        public:
+            Kind kind;
+            entt::id_type key;  // Same for the same command and type in every buffer
+
+            Queue(Kind kind, entt::id_type key) : kind(kind), key(key) {}
+            virtual ~Queue() = default;
+
+            virtual bool empty() const = 0;
+            // Moves the commands of a queue with the same key into this one
+            virtual void append(Queue& other) = 0;
+            virtual void flush(FlushContext& context) = 0;
+        };
+
+        // init(manager) runs at flush time and creates the entity, e.g. through a Builder function
+        template<typename Init>
+        void create(Init init) {
+            getQueue<CreateQueue<Init>>(Kind::Create).inits.push_back(std::move(init));
+        }
+
+        // Emplaces, or replaces if the entity already has one. Last write per entity wins, with the
+        // buffers of several threads merged by slot (see GameEntityManager::flushCommands).
+        // Applied before every remove of the flush: remove<T>(e) then emplace<T>(e) in one
+        // phase leaves e without T.
+        template<typename T, typename... Args>
+        void emplace(entt::entity id, Args&&... args) {
+            SystemAccess::check<T>(true);
+            getQueue<EmplaceQueue<T>>(Kind::Emplace).items.emplace_back(std::piecewise_construct,
+                std::forward_as_tuple(id), std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        // Applied after every emplace of the flush, whatever the record order
+        template<typename T>
+        void remove(entt::entity id) {
+            SystemAccess::check<T>(true);
+            getQueue<RemoveQueue<T>>(Kind::Remove).ids.push_back(id);
+        }
+
+        // Strips the components and returns the entity to the pool (see GameEntityManager::releaseEntity).
+        // Releasing an entity twice pools it once.
+        template<typename... T>
+        void release(entt::entity id) {
+            SystemAccess::check<Shared::Entities>(true);
+            (SystemAccess::check<T>(true), ...);
+            getQueue<ReleaseQueue<T...>>(Kind::Release).ids.push_back(id);
+        }
+
+        void destroy(entt::entity id) {
+            SystemAccess::check<Shared::Entities>(true);
+            getQueue<DestroyQueue>(Kind::Destroy).ids.push_back(id);
+        }
+
+        // Appends the queues holding commands
+        void collect(std::vector<Queue*>& out) {
+            for (auto& queue : queues) {
+                if (!queue->empty()) {
+                    out.push_back(queue.get());
+                }
+            }
+        }
+
+    private:
+        template<typename Init>
+        struct CreateQueue : Queue {
+            std::vector<Init> inits;
+            using Queue::Queue;
+
+            bool empty() const override { return inits.empty(); }
+            void append(Queue& other) override {
+                auto& from = static_cast<CreateQueue&>(other).inits;
+                std::move(from.begin(), from.end(), std::back_inserter(inits));
+                from.clear();
+            }
+            void flush(FlushContext& context) override {
+                // In record order, creation may draw random numbers
+                for (auto& init : inits) {
+                    init(context.manager);
+                }
+                inits.clear();
+            }
+        };
+
+        template<typename T>
+        struct EmplaceQueue : Queue {
+            std::vector<std::pair<entt::entity, T>> items;
+            std::vector<entt::entity> newIds;
+            std::vector<T> newComponents;
+            using Queue::Queue;
+
+            bool empty() const override { return items.empty(); }
+            void append(Queue& other) override {
+                auto& from = static_cast<EmplaceQueue&>(other).items;
+                std::move(from.begin(), from.end(), std::back_inserter(items));
+                from.clear();
+            }
+            void flush(FlushContext& context) override {
+                // Sorted by entity, so storage writes walk the sparse set in order
+                std::stable_sort(items.begin(), items.end(), [](const auto& a, const auto& b){ return a.first < b.first; });
+
+                auto& registry = context.registry;
+                for (std::size_t i = 0; i < items.size(); ++i) {
+                    auto id = items[i].first;
+                    if ((i + 1 < items.size() && items[i + 1].first == id) || !registry.valid(id)) {
+                        continue;
+                    }
+                    if (registry.all_of<T>(id)) {
+                        registry.replace<T>(id, std::move(items[i].second));
+                    } else {
+                        newIds.push_back(id);
+                        newComponents.push_back(std::move(items[i].second));
+                    }
+                }
+
+                // New components go in with one bulk insert
+                if (!newIds.empty()) {
+                    registry.insert<T>(newIds.begin(), newIds.end(), newComponents.begin());
+                }
+                items.clear();
+                newIds.clear();
+                newComponents.clear();
+            }
+        };
+
+        // Entity list commands: sorted, duplicates dropped
+        struct IdQueue : Queue {
+            std::vector<entt::entity> ids;
+            using Queue::Queue;
+
+            bool empty() const override { return ids.empty(); }
+            void append(Queue& other) override {
+                auto& from = static_cast<IdQueue&>(other).ids;
+                ids.insert(ids.end(), from.begin(), from.end());
+                from.clear();
+            }
+            void sortValid(entt::registry& registry) {
+                std::sort(ids.begin(), ids.end());
+                ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+                ids.erase(std::remove_if(ids.begin(), ids.end(), [&](auto id){ return !registry.valid(id); }), ids.end());
+            }
+        };
+
+        template<typename T>
+        struct RemoveQueue : IdQueue {
+            using IdQueue::IdQueue;
+            void flush(FlushContext& context) override {
+                this->sortValid(context.registry);
+                context.registry.template remove<T>(this->ids.begin(), this->ids.end());
+                this->ids.clear();
+            }
+        };
+
+        template<typename... T>
+        struct ReleaseQueue : IdQueue {
+            using IdQueue::IdQueue;
+            void flush(FlushContext& context) override {
+                this->sortValid(context.registry);
+                // Without the components it was released already, and must not be pooled twice
+                auto& registry = context.registry;
+                this->ids.erase(std::remove_if(this->ids.begin(), this->ids.end(),
+                    [&](auto id){ return !registry.template all_of<T...>(id); }), this->ids.end());
+                context.registry.template remove<T...>(this->ids.begin(), this->ids.end());
+                context.entityPool.insert(context.entityPool.end(), this->ids.begin(), this->ids.end());
+                this->ids.clear();
+            }
+        };
+
+        struct DestroyQueue : IdQueue {
+            using IdQueue::IdQueue;
+            void flush(FlushContext& context) override {
+                this->sortValid(context.registry);
+                context.registry.destroy(this->ids.begin(), this->ids.end());
+                this->ids.clear();
+            }
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::unordered_map<entt::id_type, Queue*> queuesByKey;
+
+        template<typename Q>
+        Q& getQueue(Kind kind) {
+            const entt::id_type key = entt::type_hash<Q>::value();
+            auto it = queuesByKey.find(key);
+            if (it != queuesByKey.end()) {
+                return static_cast<Q&>(*it->second);
+            }
+            queues.push_back(std::make_unique<Q>(kind, key));
+            queuesByKey[key] = queues.back().get();
+            return static_cast<Q&>(*queues.back());
+        }
+    };
+}
+
+#endif // COMMAND_BUFFER_HPP
@@ -0,0 +1,177 @@
+#ifndef FACTION_SUMMARY_HPP
+#define FACTION_SUMMARY_HPP
+
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+#include <vector>
+#include <entt/entity/registry.hpp>
+
+using EntityID = entt::entity;
+
+#include "Components/FactionComponent.hpp"
+#include "Components/GarissonComponent.hpp"
+#include "Components/FleetComponent.hpp"
+#include "Components/FactoryComponent.hpp"
+#include "Components/PowerPlantComponent.hpp"
+#include "Components/AttackOrderComponent.hpp"
+
+namespace Game {
+
+    // Per-faction totals (drones, energy, production), garrisons and attack orders,
+    // kept up to date from component signals: a change only marks the entity, and
+    // refresh() recounts the marked entities. Costs O(changes), not O(entities).
+    class FactionSummary {
+    public:
+        struct Totals {
+            unsigned int drones = 0;        // Parked in garrisons and in flight
+            unsigned int energy = 0;
+            float production = 0.f;         // Drones per second
+        };
+
+        using Counts = std::unordered_map<entt::entity, unsigned int>;
+
+    private:
+        // What an entity currently adds to the summary
+        struct Entry {
+            Components::Faction faction = Components::Faction::NEUTRAL;
+            bool garrison = false;
+            unsigned int garrisonDrones = 0;
+            unsigned int fleetDrones = 0;
+            unsigned int energy = 0;
+            float production = 0.f;
+            entt::entity orderSource{entt::null};
+            entt::entity orderTarget{entt::null};
+            bool dirty = false;
+        };
+
+        std::unordered_map<entt::entity, Entry> entries;
+        std::vector<entt::entity> dirty;
+
+        std::array<Totals, Components::FACTION_COUNT> totals{};
+        std::array<std::vector<entt::entity>, Components::FACTION_COUNT> garrisons;    // Holding drones, sorted
+        std::array<Counts, Components::FACTION_COUNT> orderSources;
+        std::array<Counts, Components::FACTION_COUNT> orderTargets;
+
+        static std::size_t index(Components::Faction faction) { return static_cast<std::size_t>(faction); }
+
+        static void count(Counts& counts, entt::entity id, bool add) {
+            if (id == entt::null) {
+                return;
+            }
+            if (add) {
+                counts[id]++;
+            } else if (--counts[id] == 0) {
+                counts.erase(id);
+            }
+        }
+
+        // Adds (or takes back) everything an entry contributes
+        void apply(entt::entity id, const Entry& entry, bool add) {
+            std::size_t f = index(entry.faction);
+            auto& factionTotals = totals[f];
+            unsigned int drones = entry.garrisonDrones + entry.fleetDrones;
+            factionTotals.drones = add ? factionTotals.drones + drones : factionTotals.drones - drones;
+            factionTotals.energy = add ? factionTotals.energy + entry.energy : factionTotals.energy - entry.energy;
+            factionTotals.production += add ? entry.production : -entry.production;
+
+            if (entry.garrison && entry.garrisonDrones > 0) {
+                auto& list = garrisons[f];
+                auto it = std::lower_bound(list.begin(), list.end(), id);
+                if (add) {
+                    list.insert(it, id);
+                } else {
+                    list.erase(it);
+                }
+            }
+
+            count(orderSources[f], entry.orderSource, add);
+            count(orderTargets[f], entry.orderTarget, add);
+        }
+
+        static Entry measure(const entt::registry& registry, entt::entity id) {
+            Entry entry;
+            if (!registry.valid(id)) {
+                return entry;
+            }
+            if (auto* faction = registry.try_get<Components::FactionComponent>(id)) {
+                entry.faction = faction->faction;
+            }
+            if (auto* garisson = registry.try_get<Components::GarissonComponent>(id)) {
+                entry.garrison = true;
+                entry.garrisonDrones = garisson->getDroneCount();
+            }
+            if (auto* fleet = registry.try_get<Components::FleetComponent>(id)) {
+                entry.fleetDrones = fleet->droneCount;
+            }
+            if (auto* powerPlant = registry.try_get<Components::PowerPlantComponent>(id)) {
+                entry.energy = powerPlant->capacity;
+            }
+            if (auto* factory = registry.try_get<Components::FactoryComponent>(id)) {
+                entry.production = factory->droneProductionRate;
+            }
+            if (auto* order = registry.try_get<Components::AttackOrderComponent>(id)) {
+                if (order->target != entt::null) {
+                    entry.orderSource = order->origin;
+                    entry.orderTarget = order->target;
+                }
+            }
+            return entry;
+        }
+
+    public:
+        // Registry signal handler, connected by GameEntityManager for every component counted here.
+        // Those components are only written by systems that conflict with each other, so
+        // handlers never run concurrently.
+        void onChange(entt::registry& registry, entt::entity id) {
+            auto& entry = entries[id];
+            if (!entry.dirty) {
+                entry.dirty = true;
+                dirty.push_back(id);
+            }
+        }
+
+        // Recounts the entities changed since the last refresh
+        void refresh(const entt::registry& registry) {
+            for (auto id : dirty) {
+                auto it = entries.find(id);
+                apply(id, it->second, false);
+
+                Entry current = measure(registry, id);
+                if (!registry.valid(id) || (!current.garrison && current.fleetDrones == 0 && current.energy == 0 &&
+                        current.production == 0.f && current.orderTarget == entt::null)) {
+                    entries.erase(it);
+                    continue;
+                }
+                apply(id, current, true);
+                it->second = current;
+            }
+            dirty.clear();
+        }
+
+        const Totals& getTotals(Components::Faction faction) const { return totals[index(faction)]; }
+
+        // Garrisons of the faction holding at least one drone, by entity ID
+        const std::vector<entt::entity>& getGarrisons(Components::Faction faction) const { return garrisons[index(faction)]; }
+
+        unsigned int getGarrisonDrones(entt::entity id) const {
+            auto it = entries.find(id);
+            return it != entries.end() ? it->second.garrisonDrones : 0;
+        }
+
+        Components::Faction getFaction(entt::entity id) const {
+            auto it = entries.find(id);
+            return it != entries.end() ? it->second.faction : Components::Faction::NEUTRAL;
+        }
+
+        // Some entity of the faction holds an attack order from / against id
+        bool hasOrderFrom(Components::Faction faction, entt::entity id) const { return orderSources[index(faction)].count(id) > 0; }
+        bool hasOrderAgainst(Components::Faction faction, entt::entity id) const { return orderTargets[index(faction)].count(id) > 0; }
+
+        // Every entity some entity of the faction holds an attack order from / against, with how many
+        const Counts& getOrderSources(Components::Faction faction) const { return orderSources[index(faction)]; }
+        const Counts& getOrderTargets(Components::Faction faction) const { return orderTargets[index(faction)]; }
+    };
+}
+
+#endif // FACTION_SUMMARY_HPP
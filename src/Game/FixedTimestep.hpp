@@ -0,0 +1,44 @@
+#ifndef FIXED_TIMESTEP_HPP
+#define FIXED_TIMESTEP_HPP
+
+#include <cmath>
+
+namespace Game {
+
+    // Accumulates frame time and hands it out in fixed simulation steps.
+    // The remainder is exposed as an interpolation factor for rendering.
+    class FixedTimestep {
+    private:
+        float stepSeconds;
+        unsigned int maxCatchUpSteps;
+        float accumulator = 0.f;
+
+    public:
+        FixedTimestep(unsigned int tickRateHz, unsigned int maxCatchUpSteps)
+            : stepSeconds(1.f / static_cast<float>(tickRateHz)), maxCatchUpSteps(maxCatchUpSteps) {}
+
+        // Returns the number of fixed steps to run for this frame
+        unsigned int advance(float frameSeconds) {
+            accumulator += frameSeconds;
+
+            unsigned int steps = 0;
+            while (accumulator >= stepSeconds && steps < maxCatchUpSteps) {
+                accumulator -= stepSeconds;
+                steps++;
+            }
+
+            // Too far behind (slow frame, debugger break): drop the backlog instead of spiralling
+            if (accumulator >= stepSeconds) {
+                accumulator = std::fmod(accumulator, stepSeconds);
+            }
+            return steps;
+        }
+
+        // How far between the previous and the current tick we are [0, 1)
+        float getAlpha() const { return accumulator / stepSeconds; }
+
+        float getStepSeconds() const { return stepSeconds; }
+    };
+}
+
+#endif // FIXED_TIMESTEP_HPP
@@ -3,17 +3,36 @@
 
 #include <vector>
 #include <unordered_map>
+#include <algorithm>
+#include <array>
+#include <random>
 #include <entt/entity/registry.hpp>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <tuple>
 
 // Include necessary components
 #include "Components/FactoryComponent.hpp"
+#include "Components/PowerPlantComponent.hpp"
+#include "Components/GarissonComponent.hpp"
 #include "Components/DroneComponent.hpp"
 #include "Components/ShieldComponent.hpp"
 #include "Components/GameStateComponent.hpp"
 #include "Components/AIComponent.hpp"
 #include "Components/AttackOrderComponent.hpp"
+#include "Components/TransformComponent.hpp"
+#include "Components/ShapeComponent.hpp"
+#include "Components/SelectableComponent.hpp"
+#include "Config.hpp"
 #include "Game/SignalHandlers.hpp"
+#include "Game/SpatialGrid.hpp"
+#include "Game/FactionSummary.hpp"
+#include "Game/NeighbourTable.hpp"
+#include "Game/MovementBuffers.hpp"
+#include "Game/SystemAccess.hpp"
+#include "Game/CommandBuffer.hpp"
+#include "Utils/JobSystem.hpp"
 
 #define NullEntityID entt::null
 using EntityID = entt::entity;
@@ -22,22 +41,121 @@ namespace Game {
 
     class GameEntityManager {
     private:
+        // Positions of every entity with a TransformComponent.
+        // Declared before the registry so it outlives the registry's signals.
+        SpatialGrid spatialGrid;
+
+        // What the AI perceives, kept current from signals (same lifetime rule as the grid)
+        FactionSummary factionSummary;
+        NeighbourTable neighbourTable;
+        Components::AIPerception aiPerception;  // Swept from both, shared by every AI
+
         entt::registry registry;
 
         // Special entities
         EntityID gameStateEntityID{ entt::null };
-        EntityID AIEntityID{ entt::null };
+        std::array<EntityID, Components::FACTION_COUNT> AIEntityIDs;    // By the faction each AI plays
+
+        // No window/fonts available: skip presentation-only components
+        bool headless = false;
+
+        // Released entities waiting to be reused, their component slots stay allocated
+        std::vector<EntityID> entityPool;
+
+        // Selected entities, kept in sync with SelectableComponent::isSelected
+        std::vector<EntityID> selection;
+        std::vector<EntityID> queryScratch;
+        std::vector<EntityID> pickScratch;      // For callers of pickEntities, so each manager has its own
+        std::vector<EntityID> viewScratch;      // Entities near the camera, for SnapshotSystem
+
+        EntityID hoveredEntity{ entt::null };
+
+        // Entities moving to a target, see MovementSystem
+        MovementBuffers movementBuffers;
+
+        // Simulation clock, advanced once per fixed step
+        double simulationTime = 0.0;
+        float lastStepSeconds = 0.f;
+
+        // Every random draw of a match, so a seeded match is reproducible next to others
+        std::mt19937 randomEngine;
+
+    public:
+        struct ScheduledArrival {
+            double time;
+            EntityID id;
+        };
+
+    private:
+        template<typename T>
+        void connectSummary() {
+            registry.on_construct<T>().template connect<&FactionSummary::onChange>(factionSummary);
+            registry.on_update<T>().template connect<&FactionSummary::onChange>(factionSummary);
+            registry.on_destroy<T>().template connect<&FactionSummary::onChange>(factionSummary);
+        }
+
+        // Command buffers by slot, applied by flushCommands() in slot order: 0 for the thread
+        // stepping the manager, 1 + i for job system worker i
+        std::mutex commandMutex;
+        std::vector<std::unique_ptr<CommandBuffer>> commandBuffers;
+        std::vector<CommandBuffer::Queue*> flushQueues;
+
+        // Min-heap of fleet arrivals, earliest first
+        std::vector<ScheduledArrival> arrivals;
+
+        static bool arrivesLater(const ScheduledArrival& a, const ScheduledArrival& b) {
+            if (a.time != b.time) {
+                return a.time > b.time;
+            }
+            // Same time: fixed order by ID so runs stay deterministic
+            return entt::to_integral(a.id) > entt::to_integral(b.id);
+        }
 
     public:
         // Default Constructor
-        GameEntityManager() = default;
+        GameEntityManager() {
+            AIEntityIDs.fill(entt::null);
+
+            // Change tracking for labels, writes to these components must go through patchComponent
+            registry.on_construct<Components::GarissonComponent>().connect<&SignalHandlers::markLabelDirty>();
+            registry.on_update<Components::GarissonComponent>().connect<&SignalHandlers::markLabelDirty>();
+            registry.on_construct<Components::FactoryComponent>().connect<&SignalHandlers::markLabelDirty>();
+            registry.on_update<Components::FactoryComponent>().connect<&SignalHandlers::markLabelDirty>();
+            registry.on_construct<Components::PowerPlantComponent>().connect<&SignalHandlers::markLabelDirty>();
+            registry.on_update<Components::PowerPlantComponent>().connect<&SignalHandlers::markLabelDirty>();
+
+            // Cell membership follows the transform. Positions written outside MovementSystem (which
+            // updates the cells of what it moves) must go through patchComponent.
+            registry.on_construct<Components::TransformComponent>().connect<&SpatialGrid::onTransformConstruct>(spatialGrid);
+            registry.on_update<Components::TransformComponent>().connect<&SpatialGrid::onTransformUpdate>(spatialGrid);
+            registry.on_destroy<Components::TransformComponent>().connect<&SpatialGrid::onTransformDestroy>(spatialGrid);
+
+            // Movers live in the SoA buffers until they arrive, writes to MoveComponent must go through patchComponent
+            registry.on_construct<Components::MoveComponent>().connect<&MovementBuffers::onMoveChange>(movementBuffers);
+            registry.on_update<Components::MoveComponent>().connect<&MovementBuffers::onMoveChange>(movementBuffers);
+            registry.on_destroy<Components::MoveComponent>().connect<&MovementBuffers::onMoveDestroy>(movementBuffers);
+
+            // Perception counts change with these, writes must go through patchComponent
+            connectSummary<Components::FactionComponent>();
+            connectSummary<Components::GarissonComponent>();
+            connectSummary<Components::FleetComponent>();
+            connectSummary<Components::FactoryComponent>();
+            connectSummary<Components::PowerPlantComponent>();
+            connectSummary<Components::AttackOrderComponent>();
+            registry.on_construct<Components::GarissonComponent>().connect<&NeighbourTable::invalidate>(neighbourTable);
+            registry.on_destroy<Components::GarissonComponent>().connect<&NeighbourTable::invalidate>(neighbourTable);
+        }
 
         // Prevent Copying
         GameEntityManager(const GameEntityManager&) = delete;
         GameEntityManager& operator=(const GameEntityManager&) = delete;
 
+        void setHeadless(bool value) { headless = value; }
+        bool isHeadless() const { return headless; }
+
         // Create Entity
         EntityID createEntity() {
+            SystemAccess::check<Shared::Entities>(true);
             EntityID id = registry.create();
             // std::cout << "Entity created: " << static_cast<std::uint32_t>(id) << "\n";
             return id;
@@ -45,15 +163,235 @@ namespace Game {
 
         // Destroy Entity
         void removeEntity(EntityID id) {
+            SystemAccess::check<Shared::Entities>(true);
             if (registry.valid(id)) {
                 registry.destroy(id);
                 // std::cout << "Entity destroyed: " << static_cast<std::uint32_t>(id) << "\n";
             }
         }
 
+        // Reuse a released entity if there is one
+        EntityID acquireEntity() {
+            SystemAccess::check<Shared::Entities>(true);
+            if (!entityPool.empty()) {
+                EntityID id = entityPool.back();
+                entityPool.pop_back();
+                return id;
+            }
+            return createEntity();
+        }
+
+        // Strip the given components and keep the entity for acquireEntity().
+        // An entity without them was released already and is not pooled twice.
+        template<typename... T>
+        void releaseEntity(EntityID id) {
+            SystemAccess::check<Shared::Entities>(true);
+            (SystemAccess::check<T>(true), ...);
+            if (registry.valid(id) && registry.all_of<T...>(id)) {
+                registry.remove<T...>(id);
+                entityPool.push_back(id);
+            }
+        }
+
+        std::size_t getPooledEntityCount() const { return entityPool.size(); }
+
+        SpatialGrid& getSpatialGrid() {
+            SystemAccess::check<Shared::SpatialGrid>(true);
+            return spatialGrid;
+        }
+
+        // Brings the faction summary up to date with every change since the last call
+        FactionSummary& refreshFactionSummary() {
+            SystemAccess::check<Shared::Perception>(true);
+            factionSummary.refresh(registry);
+            return factionSummary;
+        }
+
+        // Garrison neighbours out to at least maxDistance, built on first use
+        const NeighbourTable& getNeighbourTable(float maxDistance) {
+            SystemAccess::check<Shared::Perception>(true);
+            if (!neighbourTable.isValidFor(maxDistance)) {
+                neighbourTable.build(registry, spatialGrid, maxDistance);
+            }
+            return neighbourTable;
+        }
+
+        // False when getNeighbourTable(maxDistance) would rebuild the table
+        bool hasNeighbourTable(float maxDistance) const {
+            SystemAccess::check<Shared::Perception>(false);
+            return neighbourTable.isValidFor(maxDistance);
+        }
+
+        Components::AIPerception& getAIPerception() {
+            SystemAccess::check<Shared::Perception>(true);
+            return aiPerception;
+        }
+
+        std::mt19937& getRandomEngine() {
+            SystemAccess::check<Shared::Random>(true);
+            return randomEngine;
+        }
+
+        void advanceSimulationTime(float dt) {
+            simulationTime += dt;
+            lastStepSeconds = dt;
+        }
+        double getSimulationTime() const { return simulationTime; }
+        float getLastStepSeconds() const { return lastStepSeconds; }
+
+        void scheduleArrival(double time, EntityID id) {
+            SystemAccess::check<Shared::Arrivals>(true);
+            arrivals.push_back({time, id});
+            std::push_heap(arrivals.begin(), arrivals.end(), &arrivesLater);
+        }
+
+        // Pops the earliest arrival if it is due at `now`
+        bool popArrival(double now, ScheduledArrival& out) {
+            SystemAccess::check<Shared::Arrivals>(true);
+            if (arrivals.empty() || arrivals.front().time > now) {
+                return false;
+            }
+            std::pop_heap(arrivals.begin(), arrivals.end(), &arrivesLater);
+            out = arrivals.back();
+            arrivals.pop_back();
+            return true;
+        }
+
+        // Structural changes recorded here are applied at the next flushCommands().
+        // Threads outside the job system share the first buffer: only the thread stepping the
+        // manager may record from outside it, and the manager is served by a single pool.
+        CommandBuffer& getCommandBuffer() {
+            auto worker = Utils::JobSystem::getCurrentWorker();
+            std::size_t slot = worker ? *worker + 1 : 0;
+
+            std::lock_guard<std::mutex> lock(commandMutex);
+            if (slot >= commandBuffers.size()) {
+                commandBuffers.resize(slot + 1);
+            }
+            auto& buffer = commandBuffers[slot];
+            if (!buffer) {
+                buffer = std::make_unique<CommandBuffer>();
+            }
+            return *buffer;
+        }
+
+        // Sync point: applies the commands of every thread, nothing may be recording.
+        // Commands are grouped by kind and component type and applied in batches sorted by entity.
+        // The same command from several threads is merged in slot order: the stepping thread's
+        // commands first, then each worker's by index. That order depends only on which thread
+        // recorded a command, not on timing; which thread runs which system or chunk is still up
+        // to the job system, so last-write-wins between threads is only reproducible when each
+        // entity is written from one system and chunk.
+        void flushCommands() {
+            flushQueues.clear();
+            {
+                std::lock_guard<std::mutex> lock(commandMutex);
+                for (auto& buffer : commandBuffers) {
+                    if (buffer) {
+                        buffer->collect(flushQueues);
+                    }
+                }
+            }
+            if (flushQueues.empty()) {
+                return;
+            }
+
+            std::stable_sort(flushQueues.begin(), flushQueues.end(), [](const auto* a, const auto* b){
+                return std::tie(a->kind, a->key) < std::tie(b->kind, b->key);
+            });
+
+            CommandBuffer::FlushContext context{registry, *this, entityPool};
+            for (std::size_t i = 0; i < flushQueues.size();) {
+                // Same command from several threads: merge into one batch
+                auto* queue = flushQueues[i];
+                std::size_t next = i + 1;
+                for (; next < flushQueues.size() && flushQueues[next]->key == queue->key; ++next) {
+                    queue->append(*flushQueues[next]);
+                }
+                queue->flush(context);
+                i = next;
+            }
+        }
+
+        MovementBuffers& getMovementBuffers() {
+            SystemAccess::check<Shared::MovementBuffers>(true);
+            return movementBuffers;
+        }
+
+        // Selectable entity whose shape contains point, NullEntityID if none
+        EntityID pickEntity(sf::Vector2f point) {
+            // Shapes are smaller than this, so their centers are within reach of the point
+            const float reach = Config::FACTORY_SIZE;
+            queryScratch.clear();
+            spatialGrid.query(sf::FloatRect(point.x - reach, point.y - reach, reach * 2.f, reach * 2.f), queryScratch);
+
+            for (auto id : queryScratch) {
+                auto* shape = registry.try_get<Components::ShapeComponent>(id);
+                if (shape && registry.all_of<Components::SelectableComponent>(id) &&
+                    shape->getBounds(registry.get<Components::TransformComponent>(id).getPosition()).contains(point)) {
+                    return id;
+                }
+            }
+            return entt::null;
+        }
+
+        // Reusable output for pickEntities
+        std::vector<EntityID>& getPickScratch() { return pickScratch; }
+
+        // Reusable output for the camera query of SnapshotSystem
+        std::vector<EntityID>& getViewScratch() { return viewScratch; }
+
+        // Appends selectable entities whose center lies inside rect
+        void pickEntities(const sf::FloatRect& rect, std::vector<EntityID>& out) {
+            queryScratch.clear();
+            spatialGrid.query(rect, queryScratch);
+
+            for (auto id : queryScratch) {
+                if (registry.all_of<Components::SelectableComponent, Components::ShapeComponent>(id) &&
+                    rect.contains(registry.get<Components::TransformComponent>(id).getPosition())) {
+                    out.push_back(id);
+                }
+            }
+        }
+
+        void select(EntityID id) {
+            auto* selectable = registry.try_get<Components::SelectableComponent>(id);
+            if (selectable && !selectable->isSelected) {
+                selectable->isSelected = true;
+                selection.push_back(id);
+            }
+        }
+
+        void deselect(EntityID id) {
+            auto* selectable = registry.try_get<Components::SelectableComponent>(id);
+            if (selectable) {
+                selectable->isSelected = false;
+            }
+            selection.erase(std::remove(selection.begin(), selection.end(), id), selection.end());
+        }
+
+        void clearSelection() {
+            for (auto id : selection) {
+                if (auto* selectable = registry.try_get<Components::SelectableComponent>(id)) {
+                    selectable->isSelected = false;
+                }
+            }
+            selection.clear();
+        }
+
+        bool isSelected(EntityID id) const {
+            return std::find(selection.begin(), selection.end(), id) != selection.end();
+        }
+
+        const std::vector<EntityID>& getSelection() const { return selection; }
+
+        EntityID getHoveredEntity() const { return hoveredEntity; }
+        void setHoveredEntity(EntityID id) { hoveredEntity = id; }
+
         // Add Component
         template<typename T, typename... Args>
         T& addComponent(EntityID id, Args&&... args) {
+            SystemAccess::check<T>(true);
             T& component = registry.emplace<T>(id, std::forward<Args>(args)...);
             // std::cout << "Component added to entity: " << static_cast<std::uint32_t>(id) << "\n";
 
@@ -61,7 +399,7 @@ namespace Game {
                 gameStateEntityID = id;
             }
             if constexpr (std::is_same<T, Components::AIComponent>::value) {
-                AIEntityID = id;
+                AIEntityIDs[static_cast<std::size_t>(component.faction)] = id;
             }
 
             return component;
@@ -69,13 +407,14 @@ namespace Game {
 
         template<typename T, typename... Args>
         T& addOrReplaceComponent(EntityID id, Args&&... args) {
+            SystemAccess::check<T>(true);
             T& component = registry.emplace_or_replace<T>(id, std::forward<Args>(args)...);
 
             if constexpr (std::is_same<T, Components::GameStateComponent>::value) {
                 gameStateEntityID = id;
             }
             if constexpr (std::is_same<T, Components::AIComponent>::value) {
-                AIEntityID = id;
+                AIEntityIDs[static_cast<std::size_t>(component.faction)] = id;
             }
 
             return component;
@@ -85,6 +424,7 @@ namespace Game {
         // Remove Component
         template<typename T>
         void removeComponent(EntityID id) {
+            SystemAccess::check<T>(true);
             if (registry.all_of<T>(id)) {
                 registry.remove<T>(id);
                 // std::cout << "Component removed from entity: " << static_cast<std::uint32_t>(id) << "\n";
@@ -94,20 +434,29 @@ namespace Game {
         // Get Component (Pointer)
         template<typename T>
         T* getComponent(EntityID id) {
+            SystemAccess::check<T>(false);
             return registry.try_get<T>(id);
         }
 
         // Check if Entity has a Component
         template<typename T>
         bool hasComponent(EntityID id) {
+            SystemAccess::check<T>(false);
             return registry.all_of<T>(id);
         }
 
         template<typename... Components>
         auto view() {
+            (SystemAccess::check<Components>(false), ...);
             return registry.view<Components...>();
         }
 
+        // Creates the storage of T now rather than on first use
+        template<typename T>
+        void reserveStorage() {
+            registry.storage<T>();
+        }
+
         // Register on_update Listener
         template<typename T, typename Func>
         void onUpdate(Func&& func) {
@@ -117,6 +466,7 @@ namespace Game {
         // Patch Component
         template<typename T, typename Func>
         void patchComponent(EntityID id, Func&& func) {
+            SystemAccess::check<T>(true);
             if (registry.all_of<T>(id)) {
                 registry.patch<T>(id, std::forward<Func>(func));
                 // log_info << "Component patched for entity: " << static_cast<std::uint32_t>(id) << "\n";
@@ -127,6 +477,7 @@ namespace Game {
 
         // Get All Entity IDs
         std::vector<EntityID> getAllEntityIDs() {
+            SystemAccess::check<Shared::Entities>(false);
             // TODO: temporary until project fully migrated to entt::view 
             std::vector<EntityID> entityIDs;
 
@@ -144,16 +495,19 @@ namespace Game {
 
         // Get Game State
         Components::GameStateComponent* getGameStateComponent() {
+            SystemAccess::check<Components::GameStateComponent>(false);
             if (registry.valid(gameStateEntityID) && registry.all_of<Components::GameStateComponent>(gameStateEntityID)) {
                 return &registry.get<Components::GameStateComponent>(gameStateEntityID);
             }
             return nullptr;
         }
 
-        // Get AI
-        Components::AIComponent* getAIComponent() {
-            if (registry.valid(AIEntityID) && registry.all_of<Components::AIComponent>(AIEntityID)) {
-                return &registry.get<Components::AIComponent>(AIEntityID);
+        // Get the AI playing a faction
+        Components::AIComponent* getAIComponent(Components::Faction faction = Components::Faction::PLAYER_2) {
+            SystemAccess::check<Components::AIComponent>(false);
+            EntityID id = AIEntityIDs[static_cast<std::size_t>(faction)];
+            if (registry.valid(id) && registry.all_of<Components::AIComponent>(id)) {
+                return &registry.get<Components::AIComponent>(id);
             }
             return nullptr;
         }
@@ -0,0 +1,51 @@
+#ifndef INPUT_COMMAND_HPP
+#define INPUT_COMMAND_HPP
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace Game {
+
+    // Player input, translated to world coordinates on the window thread and
+    // applied by the simulation thread before its next tick
+    struct InputCommand {
+        enum class Type {
+            LeftClick,      // Select, or order an attack on what is under position
+            RightClick,     // Order a transfer to what is under position, or cancel
+            BoxSelect,      // Select the player garrisons inside box
+            Hover,          // Mouse moved to position (screenPosition on the window)
+            SetDifficulty,  // AI difficulty by name
+            SetView         // Camera moved: box is the world rect snapshots copy (RenderSnapshot::getCullRect)
+        };
+
+        Type type = Type::Hover;
+        sf::Vector2f position;
+        sf::Vector2f screenPosition;
+        sf::FloatRect box;
+        std::string difficulty;
+    };
+
+    // Commands from the window thread, drained once per tick by the simulation thread
+    class InputQueue {
+    private:
+        std::mutex mutex;
+        std::vector<InputCommand> pending;
+
+    public:
+        void push(InputCommand command) {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(std::move(command));
+        }
+
+        // Swaps the pending commands into out (cleared first), keeping both capacities
+        void drain(std::vector<InputCommand>& out) {
+            out.clear();
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.swap(out);
+        }
+    };
+}
+
+#endif // INPUT_COMMAND_HPP
@@ -2,11 +2,14 @@
 #define MAP_GENERATOR_HPP
 
 #include <vector>
+#include <algorithm>
 #include <cmath>
 #include <random>
 #include <SFML/System/Vector2.hpp> // Include sf::Vector2f
 
 #include "Game/GameEntityManager.hpp"
+#include "Game/Builder.hpp"
+#include "Utils/Random.hpp"
 
 namespace Game {
 
@@ -14,9 +17,9 @@ namespace Game {
     public:
         RandomPositionGenerator(float mapWidth, float mapHeight, float minDistance)
             : mapWidth(mapWidth), mapHeight(mapHeight), minDistance(minDistance),
-              gen(rd()), distX(0.0f, mapWidth), distY(0.0f, mapHeight) {}
+              distX(0.0f, mapWidth), distY(0.0f, mapHeight) {}
 
-        std::vector<sf::Vector2f> generateNonOverlappingPositions(int unitCount) {
+        std::vector<sf::Vector2f> generateNonOverlappingPositions(std::mt19937& gen, int unitCount) {
             std::vector<sf::Vector2f> positions;
             int maxAttempts = 10000;
             int attempts = 0;
@@ -34,8 +37,6 @@ namespace Game {
 
     private:
         float mapWidth, mapHeight, minDistance;
-        std::random_device rd;
-        std::mt19937 gen;
         std::uniform_real_distribution<float> distX;
         std::uniform_real_distribution<float> distY;
 
@@ -58,64 +59,69 @@ namespace Game {
         return std::sqrt(dx * dx + dy * dy);
     }
 
-    void GenerateRandomMap(Game::GameEntityManager& entityManager, float mapWidth, float mapHeight, int unitCount, float minDistance) {
-        float minPlayerDistance = 700.0f; // Minimum distance between players
+    // playerCount: factions PLAYER_1 onwards that start with a factory and a power plant
+    void GenerateRandomMap(Game::GameEntityManager& entityManager, float mapWidth, float mapHeight, int unitCount, float minDistance, unsigned int playerCount = 2) {
+        // Minimum distance between players, closer together the more players share the map
+        float minPlayerDistance = 700.0f * std::sqrt(2.f / std::max(playerCount, 2u));
 
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        auto& gen = entityManager.getRandomEngine();
         std::uniform_real_distribution<float> distX(0.0f, mapWidth);
         std::uniform_real_distribution<float> distY(0.0f, mapHeight);
 
-        // Generate starting positions for Player 1 and Player 2
-        sf::Vector2f player1Start, player2Start;
+        // Generate starting positions for every player
+        std::vector<sf::Vector2f> playerStarts(playerCount);
         bool validPlacement = false;
 
         while (!validPlacement) {
-            player1Start = {distX(gen), distY(gen)};
-            player2Start = {distX(gen), distY(gen)};
+            for (auto& start : playerStarts) {
+                start = {distX(gen), distY(gen)};
+            }
 
             // Ensure players are sufficiently far apart
-            if (calculateDistance(player1Start, player2Start) >= minPlayerDistance) {
-                validPlacement = true;
+            validPlacement = true;
+            for (std::size_t i = 0; i < playerStarts.size() && validPlacement; ++i) {
+                for (std::size_t j = i + 1; j < playerStarts.size(); ++j) {
+                    if (calculateDistance(playerStarts[i], playerStarts[j]) < minPlayerDistance) {
+                        validPlacement = false;
+                        break;
+                    }
+                }
             }
         }
 
-        // Place Player 1 Structures (Factory + Power Plant)
-        sf::Vector2f player1FactoryPos = player1Start;
-        sf::Vector2f player1PowerPlantPos = {player1Start.x + Utils::getRandomFloat(50.f, 150.f), player1Start.y + Utils::getRandomFloat(50.f, 150.f)};
-
-        auto player1Faction = Components::Faction::PLAYER_1;
+        // Place Player Structures (Factory + Power Plant), every player gets the rates of player 1
         float productionRate = 1.f;
-        float shieldRegenRate = Utils::getRandomFloat(0.75f, 1.f);
-        unsigned int capacity = Utils::getRandomFloat(13.f, 20.f);
-
-        Game::createFactory(entityManager, "Factory #0", player1FactoryPos, player1Faction, productionRate, shieldRegenRate);
-        Game::createPowerPlant(entityManager, "Power Plant #0", player1PowerPlantPos, player1Faction, shieldRegenRate, capacity);
-
-        // Place Player 2 Structures (Factory + Power Plant)
-        sf::Vector2f player2FactoryPos = player2Start;
-        sf::Vector2f player2PowerPlantPos = {player2Start.x + Utils::getRandomFloat(50.f, 150.f), player2Start.y + Utils::getRandomFloat(50.f, 150.f)};
-
-        auto player2Faction = Components::Faction::PLAYER_2;
+        float shieldRegenRate = 0.f;
+        unsigned int capacity = 0;
+
+        for (unsigned int player = 0; player < playerCount; ++player) {
+            sf::Vector2f factoryPos = playerStarts[player];
+            sf::Vector2f powerPlantPos = {factoryPos.x + Utils::getRandomFloat(gen, 50.f, 150.f), factoryPos.y + Utils::getRandomFloat(gen, 50.f, 150.f)};
+            if (player == 0) {
+                shieldRegenRate = Utils::getRandomFloat(gen, 0.75f, 1.f);
+                capacity = Utils::getRandomFloat(gen, 13.f, 20.f);
+            }
 
-        Game::createFactory(entityManager, "Factory #0", player2FactoryPos, player2Faction, productionRate, shieldRegenRate);
-        Game::createPowerPlant(entityManager, "Power Plant #0", player2PowerPlantPos, player2Faction, shieldRegenRate, capacity);
+            auto faction = static_cast<Components::Faction>(player + 1);
+            Game::createFactory(entityManager, "Factory #0", factoryPos, faction, productionRate, shieldRegenRate);
+            Game::createPowerPlant(entityManager, "Power Plant #0", powerPlantPos, faction, shieldRegenRate, capacity);
+        }
 
         // Generate Remaining Units Randomly
         Game::RandomPositionGenerator generator(mapWidth, mapHeight, minDistance);
-        auto positions = generator.generateNonOverlappingPositions(unitCount); // Adjust count as needed
+        auto positions = generator.generateNonOverlappingPositions(gen, unitCount); // Adjust count as needed
 
         for (size_t i = 0; i < positions.size(); ++i) {
-            float coinFlip = Utils::getRandomFloat(0.f, 1.f);
-            float shieldRegenRate = Utils::getRandomFloat(0.1f, 1.f);
+            float coinFlip = Utils::getRandomFloat(gen, 0.f, 1.f);
+            float shieldRegenRate = Utils::getRandomFloat(gen, 0.1f, 1.f);
 
             if (coinFlip > 0.5f) {
                 // Generate Factory
-                auto productionRate = Utils::getRandomFloat(0.1f, 0.9f);
+                auto productionRate = Utils::getRandomFloat(gen, 0.1f, 0.9f);
                 Game::createFactory(entityManager, "Factory #" + std::to_string(i), positions[i], Components::Faction::NEUTRAL, productionRate, shieldRegenRate);
             } else {
                 // Generate Power plant
-                unsigned int capacity = Utils::getRandomFloat(5.f, 25.f);
+                unsigned int capacity = Utils::getRandomFloat(gen, 5.f, 25.f);
                 Game::createPowerPlant(entityManager, "Power Plant #" + std::to_string(i), positions[i], Components::Faction::NEUTRAL, shieldRegenRate, capacity);
             }
         }
@@ -0,0 +1,156 @@
+#ifndef MOVEMENT_BUFFERS_HPP
+#define MOVEMENT_BUFFERS_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <entt/entity/registry.hpp>
+
+#include "Components/TransformComponent.hpp"
+#include "Components/MoveComponent.hpp"
+#include "Game/SpatialGrid.hpp"
+#include "Config.hpp"
+
+namespace Game {
+
+    // Structure-of-arrays state of every entity moving to a target, kept between ticks.
+    // A row is added when a MoveComponent with moveToTarget is constructed or patched, and
+    // swap-removed when the entity arrives, stops or loses the component. While an entity
+    // moves its position lives here: MovementSystem writes the TransformComponent when it
+    // arrives, and the render snapshot reads moving positions from here.
+    struct MovementBuffers {
+        static constexpr std::uint32_t NO_ROW = ~std::uint32_t(0);
+
+        std::vector<entt::entity> ids;
+        std::vector<float> x, y;                    // Current position
+        std::vector<float> previousX, previousY;    // At the previous tick, for render interpolation
+        std::vector<float> targetX, targetY;
+        std::vector<float> speed;
+        std::vector<std::int64_t> cells;            // Spatial grid cell the entity is filed under
+        std::vector<std::uint8_t> arrived;          // Kernel output: 1 when the entity reached its target
+        std::vector<std::uint8_t> cellChanged;      // Set when the entity moved to another cell this tick
+
+        // Entities with an angular velocity, turned every tick whether they move or not
+        std::vector<entt::entity> spinning;
+
+        std::size_t size() const { return ids.size(); }
+
+        // Row of a moving entity, NO_ROW otherwise
+        std::uint32_t rowOf(entt::entity id) const {
+            auto index = entt::to_entity(id);
+            return index < rows.size() ? rows[index] : NO_ROW;
+        }
+
+        void removeRow(std::uint32_t row) {
+            std::uint32_t last = static_cast<std::uint32_t>(ids.size() - 1);
+            rows[entt::to_entity(ids[row])] = NO_ROW;
+            if (row != last) {
+                ids[row] = ids[last];
+                x[row] = x[last];
+                y[row] = y[last];
+                previousX[row] = previousX[last];
+                previousY[row] = previousY[last];
+                targetX[row] = targetX[last];
+                targetY[row] = targetY[last];
+                speed[row] = speed[last];
+                cells[row] = cells[last];
+                arrived[row] = arrived[last];
+                cellChanged[row] = cellChanged[last];
+                rows[entt::to_entity(ids[row])] = row;
+            }
+            ids.pop_back();
+            x.pop_back();
+            y.pop_back();
+            previousX.pop_back();
+            previousY.pop_back();
+            targetX.pop_back();
+            targetY.pop_back();
+            speed.pop_back();
+            cells.pop_back();
+            arrived.pop_back();
+            cellChanged.pop_back();
+        }
+
+        // Registry signal handlers for MoveComponent, connected by GameEntityManager.
+        // Writes to MoveComponent must go through patchComponent.
+        void onMoveChange(entt::registry& registry, entt::entity id) {
+            const auto& move = registry.get<Components::MoveComponent>(id);
+            auto* transform = registry.try_get<Components::TransformComponent>(id);
+            std::uint32_t row = rowOf(id);
+
+            if (move.moveToTarget && transform) {
+                if (row == NO_ROW) {
+                    row = addRow(id, transform->getPosition());
+                }
+                targetX[row] = move.targetPosition.x;
+                targetY[row] = move.targetPosition.y;
+                speed[row] = move.speed;
+
+                // Straight line to a fixed target: face it once, not every tick
+                sf::Vector2f direction = move.targetPosition - sf::Vector2f(x[row], y[row]);
+                float angle = std::atan2(direction.y, direction.x) * Config::RAD_TO_DEG;
+                transform->transform.setRotation(angle + 90.f); // Align triangle tip
+            } else if (row != NO_ROW) {
+                // Stopped on the way: the transform takes the position reached
+                if (transform) {
+                    transform->teleport(sf::Vector2f(x[row], y[row]));
+                }
+                removeRow(row);
+            }
+            setSpinning(id, move.angularVelocity != 0.f);
+        }
+
+        void onMoveDestroy(entt::registry& registry, entt::entity id) {
+            std::uint32_t row = rowOf(id);
+            if (row != NO_ROW) {
+                removeRow(row);
+            }
+            setSpinning(id, false);
+        }
+
+    private:
+        std::vector<std::uint32_t> rows;        // Row by entity index
+        std::vector<std::uint32_t> spinRows;    // Index into spinning by entity index
+
+        static void ensureIndex(std::vector<std::uint32_t>& index, entt::entity id) {
+            auto entity = entt::to_entity(id);
+            if (entity >= index.size()) {
+                index.resize(entity + 1, NO_ROW);
+            }
+        }
+
+        std::uint32_t addRow(entt::entity id, sf::Vector2f position) {
+            ensureIndex(rows, id);
+            auto row = static_cast<std::uint32_t>(ids.size());
+            rows[entt::to_entity(id)] = row;
+            ids.push_back(id);
+            x.push_back(position.x);
+            y.push_back(position.y);
+            previousX.push_back(position.x);
+            previousY.push_back(position.y);
+            targetX.push_back(position.x);
+            targetY.push_back(position.y);
+            speed.push_back(0.f);
+            cells.push_back(SpatialGrid::NO_CELL); // Filed on the first tick
+            arrived.push_back(0);
+            cellChanged.push_back(0);
+            return row;
+        }
+
+        void setSpinning(entt::entity id, bool spins) {
+            ensureIndex(spinRows, id);
+            auto& slot = spinRows[entt::to_entity(id)];
+            if (spins && slot == NO_ROW) {
+                slot = static_cast<std::uint32_t>(spinning.size());
+                spinning.push_back(id);
+            } else if (!spins && slot != NO_ROW) {
+                spinRows[entt::to_entity(spinning.back())] = slot;
+                spinning[slot] = spinning.back();
+                spinning.pop_back();
+                slot = NO_ROW;
+            }
+        }
+    };
+}
+
+#endif // MOVEMENT_BUFFERS_HPP
@@ -0,0 +1,125 @@
+#ifndef NEIGHBOUR_TABLE_HPP
+#define NEIGHBOUR_TABLE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <entt/entity/registry.hpp>
+
+#include "Components/TransformComponent.hpp"
+#include "Components/GarissonComponent.hpp"
+#include "Game/SpatialGrid.hpp"
+
+namespace Game {
+
+    // Every garrison's neighbouring garrisons within a radius, nearest first.
+    // Garrisons never move, so the table is built once and only rebuilt when a
+    // garrison is added or removed, or a larger radius is asked for.
+    // Rows are stored back to back: one allocation, no per-garrison containers.
+    class NeighbourTable {
+    public:
+        struct Neighbour {
+            float distance;
+            entt::entity id;
+            std::uint32_t row;      // Of the neighbour itself
+        };
+
+        static constexpr std::uint32_t NO_ROW = ~std::uint32_t(0);
+
+        struct Row {
+            const Neighbour* first = nullptr;
+            const Neighbour* last = nullptr;
+            const Neighbour* begin() const { return first; }
+            const Neighbour* end() const { return last; }
+            bool empty() const { return first == last; }
+        };
+
+    private:
+        std::unordered_map<entt::entity, std::uint32_t> rows;  // Garrison -> row index
+        std::vector<entt::entity> garrisons;                    // Row index -> garrison, by ID
+        std::vector<std::uint32_t> offsets;                     // Row i is [offsets[i], offsets[i + 1])
+        std::vector<Neighbour> neighbours;
+        std::vector<entt::entity> candidates;                   // Grid query scratch
+        float radius = -1.f;
+        bool valid = false;
+
+    public:
+        // Registry signal handler: a garrison was added or removed
+        void invalidate(entt::registry& registry, entt::entity entity) { valid = false; }
+
+        bool isValidFor(float maxDistance) const { return valid && maxDistance <= radius; }
+
+        void build(entt::registry& registry, const SpatialGrid& grid, float maxDistance) {
+            rows.clear();
+            offsets.clear();
+            neighbours.clear();
+            garrisons.clear();
+
+            // Garrisons in ID order, so rows (and ties between equal distances) do not depend on storage order
+            for (auto id : registry.view<Components::GarissonComponent, Components::TransformComponent>()) {
+                garrisons.push_back(id);
+            }
+            std::sort(garrisons.begin(), garrisons.end());
+            for (std::uint32_t row = 0; row < garrisons.size(); ++row) {
+                rows[garrisons[row]] = row;
+            }
+
+            offsets.push_back(0);
+            for (auto id : garrisons) {
+                sf::Vector2f position = registry.get<Components::TransformComponent>(id).getPosition();
+
+                candidates.clear();
+                grid.query(sf::FloatRect(position.x - maxDistance, position.y - maxDistance, maxDistance * 2.f, maxDistance * 2.f), candidates);
+
+                auto rowBegin = neighbours.size();
+                for (auto other : candidates) {
+                    auto row = rows.find(other);
+                    if (other == id || row == rows.end()) {
+                        continue;
+                    }
+                    sf::Vector2f delta = registry.get<Components::TransformComponent>(other).getPosition() - position;
+                    float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+                    if (distance <= maxDistance) {
+                        neighbours.push_back({distance, other, row->second});
+                    }
+                }
+                std::sort(neighbours.begin() + rowBegin, neighbours.end(), [](const Neighbour& a, const Neighbour& b) {
+                    return a.distance != b.distance ? a.distance < b.distance : a.id < b.id;
+                });
+
+                offsets.push_back(static_cast<std::uint32_t>(neighbours.size()));
+            }
+
+            radius = maxDistance;
+            valid = true;
+        }
+
+        // Row of a garrison, NO_ROW for anything else. Rows run from 0 to getGarrisons().size(),
+        // so per-garrison data can be kept in plain arrays.
+        std::uint32_t getRow(entt::entity id) const {
+            auto it = rows.find(id);
+            return it != rows.end() ? it->second : NO_ROW;
+        }
+
+        // Neighbours of the garrison in a row, nearest first
+        Row getNeighbours(std::uint32_t row) const {
+            const Neighbour* base = neighbours.data();
+            return {base + offsets[row], base + offsets[row + 1]};
+        }
+
+        // Neighbours of a garrison, nearest first; empty for anything else
+        Row getNeighbours(entt::entity id) const {
+            auto row = getRow(id);
+            return row != NO_ROW ? getNeighbours(row) : Row{};
+        }
+
+        const std::vector<entt::entity>& getGarrisons() const { return garrisons; }
+
+        float getRadius() const { return radius; }
+        std::size_t size() const { return neighbours.size(); }
+    };
+}
+
+#endif // NEIGHBOUR_TABLE_HPP
@@ -0,0 +1,59 @@
+#ifndef RENDER_CACHE_HPP
+#define RENDER_CACHE_HPP
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+#include "Game/GameEntityManager.hpp"
+
+namespace Game {
+
+    // Geometry and text kept by RenderSystem between frames, owned by whoever renders
+    struct RenderCache {
+        // Structures, fleets and drones, rebuilt every frame
+        sf::VertexArray shapeVertices{sf::Triangles};
+
+        // Shield rings. Each shield owns a fixed range of SHIELD_SLOT_VERTICES in shieldVertices,
+        // rewritten in place only when that shield crosses a quantum or moves. Vertices past its
+        // rings, and free slots, are left degenerate so they draw nothing.
+        static constexpr int MAX_SHIELD_RINGS = 3;  // 10 shield per ring, power plants hold up to 25
+        static constexpr std::size_t SHIELD_SLOT_VERTICES = MAX_SHIELD_RINGS * 50 * 6;  // Rings * RING_SEGMENTS * 6
+        struct ShieldEntry {
+            int segments = -1;          // Quantized shield level, in arc segments
+            sf::Vector2f center;
+            unsigned long frame = 0;    // Last frame the entity was seen
+            std::size_t slot = 0;
+            std::size_t vertexCount = 0;    // Written at the start of the slot, the rest is degenerate
+        };
+        std::unordered_map<EntityID, ShieldEntry> shields;
+        std::vector<std::size_t> freeShieldSlots;
+        sf::VertexArray shieldVertices{sf::Triangles};
+
+        // Transfer routes by (source, target), rebuilt only when a route is added, removed or moved
+        struct RouteEntry {
+            sf::Vector2f start;
+            sf::Vector2f end;
+            unsigned long frame = 0;
+        };
+        std::map<std::pair<EntityID, EntityID>, RouteEntry> routes;
+        sf::VertexArray routeVertices{sf::Triangles};
+
+        // Label texts by entity, laid out again only when the snapshot strings change
+        struct LabelEntry {
+            sf::Text text;
+            sf::Text count;
+            std::uint32_t version = 0;
+            bool initialized = false;
+            unsigned long frame = 0;
+        };
+        std::unordered_map<EntityID, LabelEntry> labels;
+
+        unsigned long frame = 0;
+    };
+}
+
+#endif // RENDER_CACHE_HPP
@@ -0,0 +1,127 @@
+#ifndef RENDER_SNAPSHOT_HPP
+#define RENDER_SNAPSHOT_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+#include "Components/FactionComponent.hpp"
+#include "Components/ShapeComponent.hpp"
+#include "Components/FleetComponent.hpp"
+#include "Components/FlightComponent.hpp"
+#include "Components/GameStateComponent.hpp"
+
+#include "Game/GameEntityManager.hpp"
+
+namespace Game {
+
+    // What the window thread draws, copied out of the registry after a simulation tick
+    // (see Systems::SnapshotSystem). Immutable once published; the window thread never
+    // reads the registry. Vectors are refilled in place, so steady state does not allocate.
+    // Holds only what is near the camera the window thread last reported, see getCullRect.
+    struct RenderSnapshot {
+        struct Structure {
+            EntityID id = NullEntityID;
+            sf::Vector2f position;
+            Components::ShapeType shape = Components::ShapeType::Square;
+            float size = 0.f;       // Scaled half extent
+            float rotation = 0.f;
+            Components::Faction faction = Components::Faction::NEUTRAL;
+            bool selected = false;
+            bool hasShield = false;
+            float shield = 0.f;
+        };
+
+        // Loose drones (not part of a fleet), interpolated between the two positions
+        struct Drone {
+            sf::Vector2f previousPosition;
+            sf::Vector2f position;
+            float rotation = 0.f;
+            Components::Faction faction = Components::Faction::NEUTRAL;
+        };
+
+        struct Fleet {
+            Components::FleetComponent fleet;
+            Components::FlightComponent flight;
+            Components::Faction faction = Components::Faction::NEUTRAL;
+        };
+
+        struct Route {
+            EntityID source = NullEntityID;
+            EntityID target = NullEntityID;
+            sf::Vector2f start;
+            sf::Vector2f end;
+        };
+
+        struct Label {
+            EntityID id = NullEntityID;
+            std::uint32_t version = 0;  // Of the strings, see LabelComponent
+            sf::Vector2f position;
+            sf::Vector2f offset;
+            unsigned int fontSize = 0;
+            sf::Color color;
+            std::string text;
+            std::string count;
+        };
+
+        // The structure under the mouse, for the HUD info panel
+        struct Hover {
+            bool active = false;
+            sf::Vector2f screenPosition;
+            std::string factoryName;
+            bool isFactory = false;
+            float productionRate = 0.f;
+            bool isPowerPlant = false;
+            unsigned int capacity = 0;
+            bool hasGarrison = false;
+            unsigned int drones = 0;
+            bool hasShield = false;
+            float shield = 0.f;
+            float maxShield = 0.f;
+            float regenRate = 0.f;
+        };
+
+        unsigned long tick = 0;
+        double simulationTime = 0.0;
+        float stepSeconds = 0.f;
+        std::chrono::steady_clock::time_point publishedAt;
+
+        std::vector<Structure> structures;
+        std::vector<sf::Sprite> sprites;
+        std::vector<Drone> drones;
+        std::vector<Fleet> fleets;
+        std::vector<Route> routes;
+        std::vector<Label> labels;
+        Hover hover;
+
+        bool hasGameState = false;
+        Components::GameStateComponent gameState{0};
+
+        std::vector<sf::Vector2f> pinkDebugTargets;
+        std::vector<sf::Vector2f> yellowDebugTargets;
+
+        // Past the camera, what is drawn around an entity's center: shield rings, fleet spread, labels
+        static constexpr float CULL_MARGIN = 300.f;
+
+        // World rect the simulation copies into snapshots for a camera view
+        static sf::FloatRect getCullRect(const sf::View& view) {
+            return sf::FloatRect(
+                view.getCenter() - view.getSize() / 2.f - sf::Vector2f(CULL_MARGIN, CULL_MARGIN),
+                view.getSize() + sf::Vector2f(CULL_MARGIN, CULL_MARGIN) * 2.f);
+        }
+
+        // Interpolation factor for drawing now: the snapshot is drawn one tick behind,
+        // reaching its own state one step after it was published
+        float getAlpha(std::chrono::steady_clock::time_point now) const {
+            if (stepSeconds <= 0.f) {
+                return 1.f;
+            }
+            float alpha = std::chrono::duration<float>(now - publishedAt).count() / stepSeconds;
+            return alpha < 0.f ? 0.f : (alpha > 1.f ? 1.f : alpha);
+        }
+    };
+}
+
+#endif // RENDER_SNAPSHOT_HPP
@@ -7,43 +7,24 @@
 #include "Resources/ResourceManager.hpp"
 #include "Config.hpp"
 
-#include "Components/FactionComponent.hpp"
-#include "Components/FactoryComponent.hpp"
-#include "Components/PowerPlantComponent.hpp"
-#include "Components/DroneComponent.hpp"
-#include "Components/TransformComponent.hpp"
-#include "Components/SpriteComponent.hpp"
-#include "Components/ShapeComponent.hpp"
-#include "Components/LabelComponent.hpp"
-#include "Components/TagComponent.hpp"
-#include "Components/HoverComponent.hpp"
-#include "Components/GameStateComponent.hpp"
-#include "Components/AIComponent.hpp"
-#include <Components/DebugOverlayComponent.hpp>
-
-#include "Systems/MovementSystem.hpp"
+// Gameplay systems live in Game::Simulation and run on the simulation thread,
+// only systems drawing the snapshot or feeding the GUI run here
 #include "Systems/RenderSystem.hpp"
-#include "Systems/LabelUpdateSystem.hpp"
-#include "Systems/InputSelectionSystem.hpp"
-#include "Systems/InputHoverSystem.hpp"
 #include "Systems/HudSystem.hpp"
-#include "Systems/ProductionSystem.hpp"
-#include "Systems/CombatSystem.hpp"
-#include "Systems/ShieldSystem.hpp"
-#include "Systems/AI/AISystem.hpp"
-#include "Systems/GameStateSystem.hpp"
-#include "Systems/DroneTransferSystem.hpp"
 #include "Systems/DebugOverlaySystem.hpp"
+#include "Systems/ProfilerOverlaySystem.hpp"
 
-#include "Game/Builder.hpp"
-#include "Game/MapGenerator.hpp"
+#include <chrono>
+#include <ctime>
 
-#include "Utils/Random.hpp"
-
-Scene::Scene(sf::RenderWindow& window) : windowRef(window)
+Scene::Scene(sf::RenderWindow& window, unsigned int seed, unsigned int tickRateHz)
+    : simulation(seed, tickRateHz, profiler), windowRef(window)
 {
     log_info << "Creating Scene";
 
+    // Systems running on this thread record into the scene's profiler
+    Utils::Profiler::setCurrent(&profiler);
+
     camera = sf::View(sf::FloatRect(0, 0, Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT));
     cameraPosition = sf::Vector2f(Config::SCREEN_WIDTH/2, Config::SCREEN_HEIGHT/2); // Start at center
 
@@ -72,45 +53,76 @@ Scene::Scene(sf::RenderWindow& window) : windowRef(window)
     //     }
     // );
 
-    // Create Game State Entity
-    EntityID gameStateID = manager.createEntity();
-    manager.addComponent<Components::GameStateComponent>(gameStateID, 2);
-
-    EntityID enemyAI = manager.createEntity();
-    manager.addComponent<Components::AIComponent>(enemyAI);
+    // Signal Handlers
+    // manager.registerSignalHandlers();
 
-    if (Config::ENABLE_DEBUG_SYMBOLS) {
-        EntityID debugID = manager.createEntity();
-        manager.addComponent<Components::DebugOverlayComponent>(debugID);
-    }
+    registerPresentationSystems();
 
-    // Generate Map
-    Game::GenerateRandomMap(manager, Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT, 30, 100);
+    snapshot = &simulation.acquireSnapshot();
+    simulation.start();
+}
 
-    // Signal Handlers
-    // manager.registerSignalHandlers();
+void Scene::registerPresentationSystems()
+{
+    using Game::Reads;
+    using Game::Writes;
+    using Game::Rate;
+
+    // Hover is picked by the simulation, which owns the spatial grid
+    presentation.addSystem("InputHover",
+        Reads<>{},
+        Writes<>{},
+        [this](float dt){
+            Game::InputCommand command;
+            command.type = Game::InputCommand::Type::Hover;
+            command.position = lastMouseWorldPosition;
+            command.screenPosition = static_cast<sf::Vector2f>(sf::Mouse::getPosition(windowRef));
+            simulation.post(std::move(command));
+        },
+        Rate::when([this](){
+            sf::Vector2f mouseWorldPosition = windowRef.mapPixelToCoords(sf::Mouse::getPosition(windowRef));
+            if (mouseWorldPosition == lastMouseWorldPosition) {
+                return false;
+            }
+            lastMouseWorldPosition = mouseWorldPosition;
+            return true;
+        }));
+
+    presentation.addSystem("Hud",
+        Reads<>{},
+        Writes<>{},
+        [this](float dt){
+            Systems::HudSystem(*snapshot, debugOverlay, *gui, simulation.getInput());
+            Systems::ProfilerOverlaySystem(profiler, profilerOverlay, *gui, showProfiler);
+        },
+        Rate::every(Config::HUD_UPDATE_INTERVAL_SEC));
+
+    presentation.addSystem("DebugOverlay",
+        Reads<>{},
+        Writes<>{},
+        [this](float dt){ Systems::DebugOverlaySystem(debugOverlay, dt); });
 }
 
 Scene::~Scene()
 {
     log_info << "Destroying Scene";
+    simulation.stop();
+    Utils::Profiler::setCurrent(nullptr);
     log_info << "Releasing GUI resources";
     gui.release();
 }
 
 void Scene::update(float dt)
 {
-    Systems::InputHoverSystem(manager, windowRef);
-    Systems::HudSystem(manager, *gui);
-    Systems::ProductionSystem(manager, dt);
-    Systems::DroneTransferSystem(manager, dt);
-    Systems::MovementSystem(manager, dt);
-    Systems::ShieldSystem(manager, dt);
-    Systems::CombatSystem(manager, dt);
-    Systems::LabelUpdateSystem(manager, dt);
-    Systems::AI::AISystem(manager, dt);
-    Systems::GameStateSystem(manager, dt);
-    Systems::DebugOverlaySystem(manager, dt);
+    static const std::size_t frameSection = Utils::Profiler::getSectionId("Frame");
+    profiler.beginFrame();
+    profiler.record(frameSection, dt * 1000.f);
+
+    // Whatever the simulation thread published last; ticks no longer run here
+    snapshot = &simulation.acquireSnapshot();
+
+    // Hover, HUD, FPS: each at its own rate
+    presentation.run(dt);
 
     // Wrap Camera Position
     cameraPosition.x = fmod(cameraPosition.x + Config::MAP_WIDTH, Config::MAP_WIDTH);
@@ -118,18 +130,52 @@ void Scene::update(float dt)
     // Update Camera
     camera.setCenter(cameraPosition);
     this->windowRef.setView(camera);
+
+    // Snapshots hold only what is near the camera: tell the simulation when it moves
+    sf::FloatRect viewRect = Game::RenderSnapshot::getCullRect(camera);
+    if (viewRect != reportedView) {
+        reportedView = viewRect;
+        Game::InputCommand command;
+        command.type = Game::InputCommand::Type::SetView;
+        command.box = viewRect;
+        simulation.post(std::move(command));
+    }
 }
 
 void Scene::render()
 {
-    Systems::RenderSystem(manager, windowRef);
-    gui->draw();
+    {
+        PROFILE_SCOPE("Render");
+        float alpha = snapshot->getAlpha(std::chrono::steady_clock::now());
+        Systems::RenderSystem(*snapshot, windowRef, alpha, renderCache);
+    }
+    if (selectionBox.isDragging()) {
+        sf::FloatRect rect = selectionBox.getRect();
+        sf::RectangleShape box({rect.width, rect.height});
+        box.setPosition(rect.left, rect.top);
+        box.setFillColor(sf::Color(255, 255, 0, 40));
+        box.setOutlineColor(sf::Color(255, 255, 0, 200));
+        box.setOutlineThickness(1.f);
+        windowRef.draw(box);
+    }
+    {
+        PROFILE_SCOPE("GuiDraw");
+        gui->draw();
+    }
 }
 
 void Scene::handleInput(sf::Event &event)
 {
     gui->handleEvent(event);
-    Systems::InputSelectionSystem(event, manager, windowRef);
+    forwardSelectionInput(event);
+
+    // Profiler hotkeys
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+        showProfiler = !showProfiler;
+    }
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F4) {
+        profiler.dumpCsv("profile_" + std::to_string(time(NULL)) + ".csv");
+    }
 
     // Handle Camera Movement
     if (sf::Keyboard::isKeyPressed(sf::Keyboard::W)) cameraPosition.y -= cameraSpeed * 0.16f;
@@ -138,3 +184,40 @@ void Scene::handleInput(sf::Event &event)
     if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) cameraPosition.x += cameraSpeed * 0.16f;
 
 }
+
+void Scene::forwardSelectionInput(const sf::Event& event)
+{
+    if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+        // Clicks resolve on release, a drag in between becomes a box selection
+        selectionBox.pressed = true;
+        selectionBox.start = windowRef.mapPixelToCoords(sf::Vector2i(event.mouseButton.x, event.mouseButton.y));
+        selectionBox.current = selectionBox.start;
+    }
+
+    if (event.type == sf::Event::MouseMoved && selectionBox.pressed) {
+        selectionBox.current = windowRef.mapPixelToCoords(sf::Vector2i(event.mouseMove.x, event.mouseMove.y));
+    }
+
+    if (event.type == sf::Event::MouseButtonReleased && event.mouseButton.button == sf::Mouse::Left && selectionBox.pressed) {
+        selectionBox.current = windowRef.mapPixelToCoords(sf::Vector2i(event.mouseButton.x, event.mouseButton.y));
+        bool dragged = selectionBox.isDragging();
+        selectionBox.pressed = false;
+
+        Game::InputCommand command;
+        if (dragged) {
+            command.type = Game::InputCommand::Type::BoxSelect;
+            command.box = selectionBox.getRect();
+        } else {
+            command.type = Game::InputCommand::Type::LeftClick;
+            command.position = selectionBox.current;
+        }
+        simulation.post(std::move(command));
+    }
+
+    if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Right) {
+        Game::InputCommand command;
+        command.type = Game::InputCommand::Type::RightClick;
+        command.position = windowRef.mapPixelToCoords(sf::Vector2i(event.mouseButton.x, event.mouseButton.y));
+        simulation.post(std::move(command));
+    }
+}
@@ -5,13 +5,34 @@
 #include <iostream>
 #include <memory>
 
+#include "Config.hpp"
+
 #include "TGUI/TGUI.hpp"
 #include "TGUI/Backend/SFML-Graphics.hpp"
-#include "Game/GameEntityManager.hpp"
+#include "Game/SimulationThread.hpp"
+#include "Game/RenderSnapshot.hpp"
+#include "Game/RenderCache.hpp"
+#include "Game/SelectionBox.hpp"
+#include "Game/SystemScheduler.hpp"
+#include "Components/DebugOverlayComponent.hpp"
+#include "Components/ProfilerOverlayComponent.hpp"
+#include "Utils/Profiler.hpp"
 
+// Window thread side of a match: draws the snapshots published by the simulation
+// thread and forwards input to it. Never touches the registry.
 class Scene{
 private:
-    Game::GameEntityManager manager;
+    // Frame profiler (F3: toggle overlay, F4: dump to CSV), also fed by the simulation thread
+    Utils::Profiler profiler;
+    Components::ProfilerOverlayComponent profilerOverlay;
+    bool showProfiler = false;
+
+    Game::SimulationThread simulation;
+    const Game::RenderSnapshot* snapshot = nullptr; // Latest one, taken each frame
+    Game::RenderCache renderCache;
+    Game::SelectionBox selectionBox;
+    Components::DebugOverlayComponent debugOverlay;
+    Game::SystemScheduler presentation; // Window thread only
     std::unique_ptr<tgui::Gui> gui;
     sf::RenderWindow& windowRef;
     
@@ -19,9 +40,16 @@ private:
     sf::View camera;
     sf::Vector2f cameraPosition;
     float cameraSpeed = 200.f;
+    sf::FloatRect reportedView;     // Last camera rect sent to the simulation, which culls snapshots to it
+
+    // Hover is picked again only when the mouse points somewhere else in the world
+    sf::Vector2f lastMouseWorldPosition{-1e9f, -1e9f};
+
+    void registerPresentationSystems();
+    void forwardSelectionInput(const sf::Event& event);
 
 public:
-    Scene(sf::RenderWindow& window);
+    Scene(sf::RenderWindow& window, unsigned int seed, unsigned int tickRateHz = Config::SIMULATION_TICK_HZ);
     ~Scene();   
     void update(float dt);
     void render();
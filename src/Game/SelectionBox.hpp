@@ -0,0 +1,30 @@
+#ifndef SELECTION_BOX_HPP
+#define SELECTION_BOX_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <SFML/Graphics.hpp>
+
+namespace Game {
+
+    // Left mouse drag in world coordinates, for box selection
+    struct SelectionBox {
+        bool pressed = false;
+        sf::Vector2f start;
+        sf::Vector2f current;
+
+        // Below this many world units a press/release is a click
+        static constexpr float DRAG_THRESHOLD = 8.f;
+
+        bool isDragging() const {
+            return pressed && (std::abs(current.x - start.x) > DRAG_THRESHOLD || std::abs(current.y - start.y) > DRAG_THRESHOLD);
+        }
+
+        sf::FloatRect getRect() const {
+            return sf::FloatRect(std::min(start.x, current.x), std::min(start.y, current.y),
+                std::abs(current.x - start.x), std::abs(current.y - start.y));
+        }
+    };
+}
+
+#endif // SELECTION_BOX_HPP
@@ -1,9 +1,19 @@
 #ifndef SIGNAL_HANDLERS_HPP
 #define SIGNAL_HANDLERS_HPP
 
+#include <entt/entity/registry.hpp>
+
+#include "Components/LabelComponent.hpp"
 #include "Utils/Logger.hpp"
 
 namespace SignalHandlers{
+    // Label text depends on a component that changed
+    inline void markLabelDirty(entt::registry& registry, entt::entity entity) {
+        if (auto* label = registry.try_get<Components::LabelComponent>(entity)) {
+            label->dirty = true;
+        }
+    }
+
     // Example handler for AttackOrderComponent updates
     inline void onAttackOrderUpdate() {
         log_info << "signal detected";
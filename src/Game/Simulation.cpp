@@ -0,0 +1,156 @@
+#include "Simulation.hpp"
+
+#include <algorithm>
+
+#include "Utils/Logger.hpp"
+#include "Utils/Profiler.hpp"
+#include "Config.hpp"
+
+#include "Components/GameStateComponent.hpp"
+#include "Components/AIComponent.hpp"
+
+#include "Systems/ProductionSystem.hpp"
+#include "Systems/DroneTransferSystem.hpp"
+#include "Systems/MovementSystem.hpp"
+#include "Systems/ShieldSystem.hpp"
+#include "Systems/CombatSystem.hpp"
+#include "Systems/AI/AISystem.hpp"
+#include "Systems/GameStateSystem.hpp"
+#include "Systems/LabelUpdateSystem.hpp"
+
+#include "Game/Builder.hpp"
+#include "Game/MapGenerator.hpp"
+
+namespace Game {
+
+    Simulation::Simulation(const MatchSettings& settings)
+    {
+        log_info << "Creating Simulation (seed " << settings.seed << (settings.headless ? ", headless)" : ")");
+
+        manager.getRandomEngine().seed(settings.seed);
+        manager.setHeadless(settings.headless);
+
+        // Players are PLAYER_1 up to the highest faction an AI plays, at least two
+        unsigned int playerCount = 2;
+        for (const auto& ai : settings.ai) {
+            playerCount = std::max(playerCount, std::min(static_cast<unsigned int>(ai.faction), Components::MAX_PLAYERS));
+        }
+
+        // Create Game State Entity
+        EntityID gameStateID = manager.createEntity();
+        manager.addComponent<Components::GameStateComponent>(gameStateID, playerCount);
+
+        // Headless matches plan inline, so the same seed always plays out the same way.
+        // Planner threads read the neighbour table while a sweep for another AI could rebuild it,
+        // so only a lone AI plans in the background.
+        bool background = !settings.headless && settings.ai.size() == 1;
+        for (const auto& ai : settings.ai) {
+            auto f = static_cast<std::size_t>(ai.faction);
+            if (ai.faction == Components::Faction::NEUTRAL || f >= Components::FACTION_COUNT || planners[f]) {
+                log_err << "Skipping AI for faction " << f << ": not a player, or already played by an AI";
+                continue;
+            }
+            EntityID aiID = manager.createEntity();
+            manager.addComponent<Components::AIComponent>(aiID, ai.faction, ai.difficulty);
+            planners[f] = std::make_unique<AIPlanner>(&Systems::AI::PlanSystem, background);
+        }
+
+        // Generate Map
+        Game::GenerateRandomMap(manager, Config::MAP_WIDTH, Config::MAP_HEIGHT, 30, 100, playerCount);
+
+        registerSystems();
+    }
+
+    void Simulation::registerSystems()
+    {
+        using namespace Components;
+
+        // Registration order is the order of conflicting systems within a tick.
+        // Patching a garrison marks its label dirty, so garrison writers also write labels.
+        // Patching anything the AI counts marks its perception, so those writers also write Shared::Perception.
+        scheduler.addSystem("Production",
+            Reads<PowerPlantComponent, FactionComponent>{},
+            Writes<FactoryComponent, GarissonComponent, LabelComponent, GameStateComponent, Shared::Perception>{},
+            [this](float dt){ Systems::ProductionSystem(manager, dt); });
+
+        scheduler.addSystem("DroneTransfer",
+            Reads<FactionComponent, GarissonComponent>{},
+            Writes<DroneTransferComponent, AttackOrderComponent, Shared::Perception>{},
+            [this](float dt){ Systems::DroneTransferSystem(manager, dt); });
+
+        scheduler.addSystem("Movement",
+            Reads<>{},
+            Writes<TransformComponent, MoveComponent, Shared::SpatialGrid, Shared::MovementBuffers>{},
+            [this](float dt){ Systems::MovementSystem(manager, dt); });
+
+        scheduler.addSystem("Shield",
+            Reads<>{},
+            Writes<ShieldComponent>{},
+            [this](float dt){ Systems::ShieldSystem(manager, dt); });
+
+        // Launches and lands fleets: creates entities and captures structures
+        scheduler.addSystem("Combat",
+            Reads<TransformComponent>{},
+            Writes<AttackOrderComponent, GarissonComponent, LabelComponent, FactionComponent, ShieldComponent, GameStateComponent,
+                FleetComponent, FlightComponent, Shared::Entities, Shared::Arrivals, Shared::Random, Shared::Perception>{},
+            [this](float dt){ Systems::CombatSystem(manager, dt); });
+
+        // Orders of the last decisions, once planned; before AI so a decision is taken after its predecessor is applied
+        scheduler.addSystem("AIExecute",
+            Reads<FactionComponent, GarissonComponent, TransformComponent>{},
+            Writes<AIComponent, AttackOrderComponent>{},
+            [this](float dt){ Systems::AI::AIExecuteSystem(manager, planners, dt); });
+
+        // One perception sweep for the AIs due a decision, each planned on its planner's thread
+        scheduler.addSystem("AI",
+            Reads<FactionComponent, FactoryComponent, PowerPlantComponent, GarissonComponent, FleetComponent,
+                ShieldComponent, TransformComponent, AttackOrderComponent, Shared::Entities>{},
+            Writes<AIComponent, Shared::Perception>{},
+            [this](float dt){ Systems::AI::AISystem(manager, planners, dt); });
+
+        scheduler.addSystem("GameState",
+            Reads<FactionComponent>{},
+            Writes<GameStateComponent>{},
+            [this](float dt){ Systems::GameStateSystem(manager, dt); },
+            Rate::every(Config::GAME_STATE_CHECK_INTERVAL_SEC));
+
+        // Label strings for the render snapshot (headless matches have no labels)
+        scheduler.addSystem("LabelUpdate",
+            Reads<FactoryComponent, PowerPlantComponent, GarissonComponent>{},
+            Writes<LabelComponent>{},
+            [this](float dt){ Systems::LabelUpdateSystem(manager, dt); },
+            Rate::every(Config::HUD_UPDATE_INTERVAL_SEC));
+
+        scheduler.logPhases();
+    }
+
+    void Simulation::step(float dt)
+    {
+        manager.advanceSimulationTime(dt);
+        scheduler.run(dt);
+
+        tickCount++;
+    }
+
+    bool Simulation::setDifficulty(const std::string& level)
+    {
+        for (auto&& [id, ai] : manager.view<Components::AIComponent>().each()) {
+            if (!ai.difficulty.setLevel(level)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Simulation::isGameOver()
+    {
+        auto* gameState = manager.getGameStateComponent();
+        return gameState && gameState->isGameOver;
+    }
+
+    Components::Faction Simulation::getWinner()
+    {
+        auto* gameState = manager.getGameStateComponent();
+        return gameState ? gameState->winner : Components::Faction::NEUTRAL;
+    }
+}
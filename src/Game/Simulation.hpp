@@ -0,0 +1,61 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Game/GameEntityManager.hpp"
+#include "Game/SystemScheduler.hpp"
+#include "Game/AIPlanner.hpp"
+#include "Config.hpp"
+
+namespace Game {
+
+    // Who plays a match. The defaults are the game: a human as player 1 against the AI on Medium.
+    // Players are PLAYER_1 up to the highest faction an AI plays; those without an AI are human.
+    struct MatchSettings {
+        struct AIPlayer {
+            Components::Faction faction;
+            Config::Difficulty difficulty;
+        };
+
+        unsigned int seed = 0;
+        bool headless = false;
+        std::vector<AIPlayer> ai = {{Components::Faction::PLAYER_2, {}}};
+    };
+
+    // Gameplay core of a match: owns the entities and steps the gameplay systems.
+    // Has no dependency on a window, TGUI or loaded fonts, so it can run headless.
+    class Simulation {
+    private:
+        GameEntityManager manager;
+        SystemScheduler scheduler{manager};
+        AIPlanners planners;    // By faction; after manager, so they join their threads before the world goes away
+        unsigned long tickCount = 0;
+
+        void registerSystems();
+
+    public:
+        explicit Simulation(const MatchSettings& settings);
+        Simulation(unsigned int seed, bool headless = false) : Simulation(MatchSettings{seed, headless}) {}
+
+        // Prevent Copying
+        Simulation(const Simulation&) = delete;
+        Simulation& operator=(const Simulation&) = delete;
+
+        // Advance all gameplay systems by dt seconds
+        void step(float dt);
+
+        // Every AI switches to a difficulty preset; false if the name is unknown
+        bool setDifficulty(const std::string& level);
+
+        bool isGameOver();
+        Components::Faction getWinner();
+
+        unsigned long getTickCount() const { return tickCount; }
+        GameEntityManager& getManager() { return manager; }
+    };
+}
+
+#endif // SIMULATION_HPP
@@ -0,0 +1,119 @@
+#include "SimulationThread.hpp"
+
+#include <chrono>
+
+#include "Config.hpp"
+#include "Utils/Logger.hpp"
+
+// Registry-side input and the snapshot copy run on the simulation thread only
+#include "Systems/InputSelectionSystem.hpp"
+#include "Systems/InputHoverSystem.hpp"
+#include "Systems/SnapshotSystem.hpp"
+
+namespace Game {
+
+    SimulationThread::SimulationThread(unsigned int seed, unsigned int tickRateHz, Utils::Profiler& profiler)
+        : simulation(seed), timestep(tickRateHz, Config::SIMULATION_MAX_CATCHUP_STEPS), profiler(profiler)
+    {
+        // The first frame has something to draw before the thread ticks
+        publishSnapshot();
+    }
+
+    SimulationThread::~SimulationThread()
+    {
+        stop();
+    }
+
+    void SimulationThread::start()
+    {
+        if (running.exchange(true)) {
+            return;
+        }
+        log_info << "Starting simulation thread";
+        thread = std::thread(&SimulationThread::run, this);
+    }
+
+    void SimulationThread::stop()
+    {
+        running = false;
+        if (thread.joinable()) {
+            thread.join();
+            log_info << "Simulation thread stopped";
+        }
+    }
+
+    void SimulationThread::run()
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // Ticks record into the scene's profiler, next to the frame sections
+        Utils::Profiler::setCurrent(&profiler);
+
+        auto previous = Clock::now();
+        while (running) {
+            auto now = Clock::now();
+            float elapsed = std::chrono::duration<float>(now - previous).count();
+            previous = now;
+
+            // Input lands between ticks
+            bool changed = applyInput();
+
+            // Gameplay runs in fixed steps, elapsed time only decides how many
+            unsigned int steps = timestep.advance(elapsed);
+            for (unsigned int i = 0; i < steps; ++i) {
+                PROFILE_SCOPE("SimulationStep");
+                simulation.step(timestep.getStepSeconds());
+            }
+
+            if (steps > 0 || changed) {
+                publishSnapshot();
+            }
+
+            // Sleep until the next tick is due
+            float untilNextTick = timestep.getStepSeconds() * (1.f - timestep.getAlpha());
+            std::this_thread::sleep_for(std::chrono::duration<float>(untilNextTick));
+        }
+
+        Utils::Profiler::setCurrent(nullptr);
+    }
+
+    bool SimulationThread::applyInput()
+    {
+        input.drain(commands);
+        if (commands.empty()) {
+            return false;
+        }
+
+        auto& manager = simulation.getManager();
+        for (const auto& command : commands) {
+            switch (command.type) {
+                case InputCommand::Type::Hover:
+                    Systems::InputHoverSystem(manager, command.position, command.screenPosition);
+                    break;
+                case InputCommand::Type::SetView:
+                    view = command.box;
+                    hasView = true;
+                    break;
+                case InputCommand::Type::SetDifficulty:
+                    if (!simulation.setDifficulty(command.difficulty)) {
+                        log_err << "Unknown AI difficulty: " << command.difficulty;
+                    }
+                    break;
+                default:
+                    Systems::InputSelectionSystem(manager, command);
+                    break;
+            }
+        }
+        manager.flushCommands();
+        return true;
+    }
+
+    void SimulationThread::publishSnapshot()
+    {
+        PROFILE_SCOPE("Snapshot");
+        auto& snapshot = snapshots.getBack();
+        Systems::SnapshotSystem(simulation.getManager(), snapshot, simulation.getTickCount(), timestep.getStepSeconds(), hasView ? &view : nullptr);
+        snapshot.publishedAt = std::chrono::steady_clock::now();
+        snapshots.publish();
+    }
+}
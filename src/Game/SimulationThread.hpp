@@ -0,0 +1,59 @@
+#ifndef SIMULATION_THREAD_HPP
+#define SIMULATION_THREAD_HPP
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "Game/Simulation.hpp"
+#include "Game/FixedTimestep.hpp"
+#include "Game/RenderSnapshot.hpp"
+#include "Game/TripleBuffer.hpp"
+#include "Game/InputCommand.hpp"
+#include "Utils/Profiler.hpp"
+
+namespace Game {
+
+    // Steps a Simulation at its fixed tick rate on a thread of its own, so slow frames
+    // and slow ticks no longer hold each other up. After every batch of ticks the state
+    // to draw is published as a RenderSnapshot; input arrives as queued commands.
+    class SimulationThread {
+    private:
+        Simulation simulation;
+        FixedTimestep timestep;
+        Utils::Profiler& profiler;
+
+        InputQueue input;
+        std::vector<InputCommand> commands; // Drained input, simulation thread only
+        TripleBuffer<RenderSnapshot> snapshots;
+        sf::FloatRect view;                 // Copied into snapshots, simulation thread only
+        bool hasView = false;               // Until the window reports its camera, everything is copied
+
+        std::atomic<bool> running{false};
+        std::thread thread;
+
+        void run();
+        bool applyInput();
+        void publishSnapshot();
+
+    public:
+        SimulationThread(unsigned int seed, unsigned int tickRateHz, Utils::Profiler& profiler);
+        ~SimulationThread();
+
+        // Prevent Copying
+        SimulationThread(const SimulationThread&) = delete;
+        SimulationThread& operator=(const SimulationThread&) = delete;
+
+        void start();
+        void stop();
+
+        // Window thread side
+        InputQueue& getInput() { return input; }
+        void post(InputCommand command) { input.push(std::move(command)); }
+
+        // Latest published state, valid until the next call
+        const RenderSnapshot& acquireSnapshot() { return snapshots.acquire(); }
+    };
+}
+
+#endif // SIMULATION_THREAD_HPP
@@ -0,0 +1,162 @@
+#ifndef SPATIAL_GRID_HPP
+#define SPATIAL_GRID_HPP
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include <entt/entity/registry.hpp>
+
+#include "Components/TransformComponent.hpp"
+
+namespace Game {
+
+    // Uniform grid over entity positions, unbounded (cells are hashed).
+    // Entities are inserted when their transform is constructed and follow it when it is patched;
+    // MovementSystem calls update() for what it moves into another cell.
+    class SpatialGrid {
+    public:
+        static constexpr std::int64_t NO_CELL = std::numeric_limits<std::int64_t>::min();
+
+    private:
+        struct Slot {
+            std::int64_t cell = NO_CELL;
+            std::size_t index = 0;  // Position inside the cell vector
+        };
+
+        float cellSize;
+        float inverseCellSize;
+        std::unordered_map<std::int64_t, std::vector<entt::entity>> cells;
+        std::vector<Slot> slots;    // By entity index, dense so moves do not hash the entity
+        std::size_t entityCount = 0;
+
+        Slot* findSlot(entt::entity entity) {
+            auto index = entt::to_entity(entity);
+            return index < slots.size() && slots[index].cell != NO_CELL ? &slots[index] : nullptr;
+        }
+
+        std::int64_t cellKey(int x, int y) const {
+            return (static_cast<std::int64_t>(x) << 32) | static_cast<std::uint32_t>(y);
+        }
+
+        // floor(value / cellSize), without the division or a call to floor: every mover is checked each tick
+        int cellCoord(float value) const {
+            float scaled = value * inverseCellSize;
+            int coord = static_cast<int>(scaled);
+            return coord - (scaled < static_cast<float>(coord));
+        }
+
+        void removeFromCell(const Slot& slot) {
+            auto& cell = cells[slot.cell];
+            // Swap with the last entity of the cell and fix its slot
+            entt::entity last = cell.back();
+            cell[slot.index] = last;
+            slots[entt::to_entity(last)].index = slot.index;
+            cell.pop_back();
+        }
+
+        void addToCell(entt::entity entity, std::int64_t key) {
+            auto& cell = cells[key];
+            auto index = entt::to_entity(entity);
+            if (index >= slots.size()) {
+                slots.resize(index + 1);
+            }
+            slots[index] = Slot{key, cell.size()};
+            cell.push_back(entity);
+        }
+
+    public:
+        explicit SpatialGrid(float cellSize = 256.f) : cellSize(cellSize), inverseCellSize(1.f / cellSize) {}
+
+        // Key of the cell holding position. Reads nothing but the cell size, so movers can be
+        // checked for a cell change off the simulation thread.
+        std::int64_t cellOf(sf::Vector2f position) const {
+            return cellKey(cellCoord(position.x), cellCoord(position.y));
+        }
+
+        void insert(entt::entity entity, sf::Vector2f position) {
+            if (findSlot(entity)) {
+                update(entity, position);
+                return;
+            }
+            addToCell(entity, cellOf(position));
+            ++entityCount;
+        }
+
+        // Cheap when the entity stays in its cell
+        void update(entt::entity entity, sf::Vector2f position) {
+            Slot* found = findSlot(entity);
+            if (!found) {
+                addToCell(entity, cellOf(position));
+                ++entityCount;
+                return;
+            }
+            std::int64_t key = cellOf(position);
+            if (found->cell == key) {
+                return;
+            }
+            Slot slot = *found;
+            removeFromCell(slot);
+            addToCell(entity, key);
+        }
+
+        void remove(entt::entity entity) {
+            Slot* found = findSlot(entity);
+            if (!found) {
+                return;
+            }
+            Slot slot = *found;
+            removeFromCell(slot);
+            slots[entt::to_entity(entity)] = Slot{};
+            --entityCount;
+        }
+
+        // Appends every entity in the cells overlapping rect. Callers filter on exact bounds.
+        void query(const sf::FloatRect& rect, std::vector<entt::entity>& out) const {
+            int minX = cellCoord(rect.left);
+            int maxX = cellCoord(rect.left + rect.width);
+            int minY = cellCoord(rect.top);
+            int maxY = cellCoord(rect.top + rect.height);
+
+            // Zoomed far out: cheaper to walk the occupied cells than the covered ones
+            if (static_cast<double>(maxX - minX + 1) * (maxY - minY + 1) > cells.size()) {
+                for (const auto& [key, cell] : cells) {
+                    int x = static_cast<int>(key >> 32);
+                    int y = static_cast<int>(static_cast<std::uint32_t>(key));
+                    if (x >= minX && x <= maxX && y >= minY && y <= maxY) {
+                        out.insert(out.end(), cell.begin(), cell.end());
+                    }
+                }
+                return;
+            }
+
+            for (int x = minX; x <= maxX; ++x) {
+                for (int y = minY; y <= maxY; ++y) {
+                    auto it = cells.find(cellKey(x, y));
+                    if (it != cells.end()) {
+                        out.insert(out.end(), it->second.begin(), it->second.end());
+                    }
+                }
+            }
+        }
+
+        std::size_t size() const { return entityCount; }
+        float getCellSize() const { return cellSize; }
+
+        // Registry signal handlers, connected by GameEntityManager
+        void onTransformConstruct(entt::registry& registry, entt::entity entity) {
+            insert(entity, registry.get<Components::TransformComponent>(entity).getPosition());
+        }
+
+        void onTransformUpdate(entt::registry& registry, entt::entity entity) {
+            update(entity, registry.get<Components::TransformComponent>(entity).getPosition());
+        }
+
+        void onTransformDestroy(entt::registry& registry, entt::entity entity) {
+            remove(entity);
+        }
+    };
+}
+
+#endif // SPATIAL_GRID_HPP
@@ -0,0 +1,83 @@
+#ifndef SYSTEM_ACCESS_HPP
+#define SYSTEM_ACCESS_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#include <entt/entity/registry.hpp>
+
+#include "Utils/JobSystem.hpp"
+#include "Utils/Logger.hpp"
+
+namespace Game {
+
+    // State outside the components that systems declare as if it were one
+    namespace Shared {
+        struct Entities {};         // Creating, destroying or listing entities
+        struct SpatialGrid {};
+        struct MovementBuffers {};
+        struct Arrivals {};         // Scheduled fleet arrivals
+        struct Random {};           // GameEntityManager::getRandomEngine()
+        struct Perception {};       // FactionSummary and NeighbourTable
+    }
+
+    template<typename... T> struct Reads {};
+    template<typename... T> struct Writes {};
+
+    // Component and resource types a system touches. Writing implies reading.
+    struct SystemAccess {
+        std::string name;
+        std::vector<entt::id_type> reads;
+        std::vector<entt::id_type> writes;
+
+        template<typename T>
+        static entt::id_type typeId() { return entt::type_hash<T>::value(); }
+
+        bool canRead(entt::id_type type) const { return contains(reads, type) || contains(writes, type); }
+        bool canWrite(entt::id_type type) const { return contains(writes, type); }
+
+        // Conflicting systems must not run at the same time
+        bool conflictsWith(const SystemAccess& other) const {
+            for (auto type : writes) {
+                if (other.canRead(type)) {
+                    return true;
+                }
+            }
+            for (auto type : other.writes) {
+                if (canRead(type)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // System running on this thread, also seen by the jobs it dispatches
+        static const SystemAccess* getCurrent() {
+            return static_cast<const SystemAccess*>(Utils::JobSystem::getContext());
+        }
+
+        // Debug builds: fail if the running system touches a type it did not declare.
+        // Code outside the scheduler (setup, input, rendering) is not checked.
+        template<typename T>
+        static void check(bool write) {
+#ifndef NDEBUG
+            const SystemAccess* current = getCurrent();
+            if (current && !(write ? current->canWrite(typeId<T>()) : current->canRead(typeId<T>()))) {
+                log_err << current->name << (write ? " writes " : " reads ") << typeid(T).name() << " without declaring it";
+                assert(false && "undeclared component access");
+            }
+#else
+            (void)write;
+#endif
+        }
+
+    private:
+        static bool contains(const std::vector<entt::id_type>& types, entt::id_type type) {
+            return std::find(types.begin(), types.end(), type) != types.end();
+        }
+    };
+}
+
+#endif // SYSTEM_ACCESS_HPP
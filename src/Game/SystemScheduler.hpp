@@ -0,0 +1,177 @@
+#ifndef SYSTEM_SCHEDULER_HPP
+#define SYSTEM_SCHEDULER_HPP
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Game/GameEntityManager.hpp"
+#include "Game/SystemAccess.hpp"
+#include "Utils/JobSystem.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/Profiler.hpp"
+
+namespace Game {
+
+    // How often a system runs. Systems that skip a tick get the time since their last run.
+    struct Rate {
+        float seconds = 0.f;                // 0: every tick
+        const float* tunable = nullptr;     // Interval read at run time instead, for settings that change
+        std::function<bool()> trigger;      // Runs only on ticks where this returns true
+
+        static Rate everyTick() { return Rate(); }
+
+        static Rate every(float seconds) {
+            Rate rate;
+            rate.seconds = seconds;
+            return rate;
+        }
+
+        static Rate following(const float& seconds) {
+            Rate rate;
+            rate.tunable = &seconds;
+            return rate;
+        }
+
+        static Rate when(std::function<bool()> trigger) {
+            Rate rate;
+            rate.trigger = std::move(trigger);
+            return rate;
+        }
+    };
+
+    // Runs the registered systems once per tick. A system runs after every earlier
+    // registered system it conflicts with (see SystemAccess); systems in the same
+    // phase do not conflict and run concurrently on the job system, unless the
+    // scheduler is serial.
+    class SystemScheduler {
+    public:
+        using SystemFunction = std::function<void(float dt)>;
+
+        explicit SystemScheduler(GameEntityManager& manager, bool concurrent = true) : manager(&manager), concurrent(concurrent) {}
+
+        // Systems that do not touch a registry (window thread): serial, nothing to flush
+        SystemScheduler() : manager(nullptr), concurrent(false) {}
+
+        // Prevent Copying
+        SystemScheduler(const SystemScheduler&) = delete;
+        SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+        template<typename... R, typename... W>
+        void addSystem(const std::string& name, Reads<R...>, Writes<W...>, SystemFunction function, Rate rate = Rate::everyTick()) {
+            Entry entry;
+            entry.access.name = name;
+            entry.access.reads = {SystemAccess::typeId<R>()...};
+            entry.access.writes = {SystemAccess::typeId<W>()...};
+            entry.function = std::move(function);
+            entry.rate = std::move(rate);
+            entry.sectionId = Utils::Profiler::getSectionId(name.c_str());
+
+            // Creating a storage later would modify the registry under concurrent systems
+            if (manager) {
+                (manager->reserveStorage<R>(), ...);
+                (manager->reserveStorage<W>(), ...);
+            }
+
+            std::size_t phase = 0;
+            for (const auto& other : systems) {
+                if (entry.access.conflictsWith(other.access)) {
+                    phase = std::max(phase, other.phase + 1);
+                }
+            }
+            entry.phase = phase;
+
+            if (phases.size() <= phase) {
+                phases.resize(phase + 1);
+            }
+            phases[phase].push_back(systems.size());
+            systems.push_back(std::move(entry));
+        }
+
+        void run(float dt) {
+            Utils::Profiler* profiler = Utils::Profiler::getCurrent();
+
+            // Timers advance for every system, whether or not its phase has anything due
+            for (auto& entry : systems) {
+                entry.elapsed += dt;
+                entry.due = isDue(entry);
+            }
+
+            auto runSystem = [&](std::size_t index) {
+                Entry& entry = systems[index];
+                if (!entry.due) {
+                    return;
+                }
+                float elapsed = entry.elapsed;
+                entry.elapsed = 0.f;
+
+                // Profile and validate on whichever thread the system lands
+                Utils::Profiler* previousProfiler = Utils::Profiler::getCurrent();
+                const void* previousContext = Utils::JobSystem::getContext();
+                Utils::Profiler::setCurrent(profiler);
+                Utils::JobSystem::setContext(&entry.access);
+                {
+                    Utils::ScopedTimer timer(entry.sectionId);
+                    entry.function(elapsed);
+                }
+                Utils::JobSystem::setContext(previousContext);
+                Utils::Profiler::setCurrent(previousProfiler);
+            };
+
+            for (const auto& phase : phases) {
+                if (!concurrent || phase.size() == 1) {
+                    for (auto index : phase) {
+                        runSystem(index);
+                    }
+                } else {
+                    Utils::JobSystem::get().parallelFor(phase.size(), 1, [&](std::size_t begin, std::size_t end) {
+                        for (std::size_t i = begin; i < end; ++i) {
+                            runSystem(phase[i]);
+                        }
+                    });
+                }
+                // Sync point: structural changes of this phase land before the next one reads
+                if (manager) {
+                    manager->flushCommands();
+                }
+            }
+        }
+
+        void logPhases() const {
+            for (std::size_t i = 0; i < phases.size(); ++i) {
+                std::string names;
+                for (auto index : phases[i]) {
+                    names += (names.empty() ? "" : ", ") + systems[index].access.name;
+                }
+                log_info << "Phase " << i << ": " << names;
+            }
+        }
+
+    private:
+        struct Entry {
+            SystemAccess access;
+            SystemFunction function;
+            Rate rate;
+            float elapsed = 0.f;    // Since the last run
+            bool due = false;
+            std::size_t sectionId = 0;
+            std::size_t phase = 0;
+        };
+
+        static bool isDue(const Entry& entry) {
+            float interval = entry.rate.tunable ? *entry.rate.tunable : entry.rate.seconds;
+            if (entry.elapsed < interval) {
+                return false;
+            }
+            return !entry.rate.trigger || entry.rate.trigger();
+        }
+
+        GameEntityManager* manager;
+        bool concurrent;
+        std::vector<Entry> systems;
+        std::vector<std::vector<std::size_t>> phases;   // Indices into systems
+    };
+}
+
+#endif // SYSTEM_SCHEDULER_HPP
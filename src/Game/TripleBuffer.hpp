@@ -0,0 +1,48 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace Game {
+
+    // Hands whole values from one writer thread to one reader thread without either waiting.
+    // The writer fills its back slot and publishes it, the reader takes the latest published
+    // slot; values published in between are skipped.
+    template<typename T>
+    class TripleBuffer {
+    private:
+        static constexpr std::uint8_t INDEX = 0x3;
+        static constexpr std::uint8_t FRESH = 0x4; // Middle slot published and not taken yet
+
+        T slots[3];
+        std::atomic<std::uint8_t> middle{1};
+        std::uint8_t back = 0;  // Writer side
+        std::uint8_t front = 2; // Reader side
+
+    public:
+        TripleBuffer() = default;
+
+        // Prevent Copying
+        TripleBuffer(const TripleBuffer&) = delete;
+        TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+        // Writer: the slot to fill. It still holds an older value, so its buffers can be reused.
+        T& getBack() { return slots[back]; }
+
+        // Writer: makes the back slot the latest value
+        void publish() {
+            back = middle.exchange(static_cast<std::uint8_t>(back | FRESH), std::memory_order_acq_rel) & INDEX;
+        }
+
+        // Reader: latest published value, valid until the next call
+        const T& acquire() {
+            if (middle.load(std::memory_order_relaxed) & FRESH) {
+                front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+            }
+            return slots[front];
+        }
+    };
+}
+
+#endif // TRIPLE_BUFFER_HPP
@@ -1,45 +1,95 @@
 #ifndef AI_SYSTEM_HPP
 #define AI_SYSTEM_HPP
 
-#include <unordered_map>
-#include <map>
-#include <unordered_set>
-#include <string>
-#include <cmath>
 #include <algorithm>
 
-
 #include "Game/GameEntityManager.hpp"
+#include "Game/AIPlanner.hpp"
 #include "Systems/AI/ExecuteSystem.hpp"
 #include "Systems/AI/PlanSystem.hpp"
 #include "Systems/AI/PerceptionSystem.hpp"
 
 #include "Config.hpp"
+#include "Utils/Profiler.hpp"
 
 namespace Systems::AI {
-        void AISystem(Game::GameEntityManager& manager, float dt) {
+        // Every tick: the AIs whose decision interval has passed take a decision. One perception
+        // sweep serves all of them, each copies its share of it and hands that to its planner.
+        // A decision still being planned is left alone and this one skipped, nothing waits for it.
+        // Plans read the neighbour table in place, so while any is in flight the table is pinned:
+        // decisions that would rebuild it (a garrison added or removed, a longer reach) wait for
+        // every planner to be done.
+        void AISystem(Game::GameEntityManager& manager, Game::AIPlanners& planners, float dt) {
+            std::array<Components::AIComponent*, Components::FACTION_COUNT> deciding{};
+            bool anyDeciding = false;
+            bool anyBusy = false;
+            float maxDistance = 0.f;
+
+            for (std::size_t f = 1; f < Components::FACTION_COUNT; ++f) {
+                auto* aiComponent = manager.getAIComponent(static_cast<Components::Faction>(f));
+                auto* planner = planners[f].get();
+                if (!aiComponent || !planner) {
+                    continue;
+                }
+                maxDistance = std::max(maxDistance, aiComponent->difficulty.maxDistanceToAttack);
 
-            // Run AI every few seconds
-            static float decisionTimer = 0.f;
+                bool busy = planner->isBusy();
+                anyBusy = anyBusy || busy;
 
-            decisionTimer += dt;
-            if(decisionTimer < Config::Difficulty::AI_DECISION_INTERVAL_SEC) {
+                aiComponent->sinceDecision += dt;
+                if (aiComponent->sinceDecision < aiComponent->difficulty.decisionIntervalSec || busy) {
+                    continue;
+                }
+                deciding[f] = aiComponent;
+                anyDeciding = true;
+            }
+
+            if (!anyDeciding || (anyBusy && !manager.hasNeighbourTable(maxDistance))) {
                 return;
             }
-            decisionTimer = 0.f;
+            for (auto* aiComponent : deciding) {
+                if (aiComponent) {
+                    aiComponent->sinceDecision = 0.f;
+                }
+            }
 
-            // Reset last plan
-            auto* aiComponent = manager.getAIComponent();
-            aiComponent->reset();
+            {
+                PROFILE_SCOPE("AI::Perception");
+                const auto& perception = Systems::AI::PerceptionSystem(manager, maxDistance, dt);
+                for (std::size_t f = 1; f < Components::FACTION_COUNT; ++f) {
+                    if (deciding[f]) {
+                        Systems::AI::snapshotPlan(perception, *deciding[f], planners[f]->getRequest());
+                    }
+                }
+            }
+            for (std::size_t f = 1; f < Components::FACTION_COUNT; ++f) {
+                if (deciding[f]) {
+                    planners[f]->submit();
+                }
+            }
+        }
 
-            // Run AI
-            Systems::AI::PerceptionSystem(manager, dt);
-            Systems::AI::PlanSystem(manager, dt);
-            Systems::AI::ExecuteSystem(manager, dt);
+        // Every tick: plans the next slice of a sliced decision, and carries out the orders
+        // of a decision once the planner has them
+        void AIExecuteSystem(Game::GameEntityManager& manager, Game::AIPlanners& planners, float dt) {
+            for (std::size_t f = 1; f < Components::FACTION_COUNT; ++f) {
+                auto faction = static_cast<Components::Faction>(f);
+                auto* aiComponent = manager.getAIComponent(faction);
+                auto* planner = planners[f].get();
+                if (!aiComponent || !planner || !planner->isBusy()) {
+                    continue;
+                }
+                planner->advance(dt);
+                if (!planner->takeOrders(aiComponent->execute.finalTargets)) {
+                    continue;
+                }
 
-            return;
+                PROFILE_SCOPE("AI::Execute");
+                aiComponent->debug.reset();
+                Systems::AI::ExecuteSystem(manager, faction, dt);
+            }
         }
 
 }
 
-#endif // AI_SYSTEM_HPP
\ No newline at end of file
+#endif // AI_SYSTEM_HPP
@@ -3,18 +3,39 @@
 
 #include "Game/GameEntityManager.hpp"
 
+#include "Components/FactionComponent.hpp"
+#include "Components/GarissonComponent.hpp"
+
 #include "Config.hpp"
 
 namespace Systems::AI {
 
-    void ExecuteSystem(Game::GameEntityManager& manager, float dt){
-        auto* aiComp = manager.getAIComponent();
-    
+    // Orders were planned from a snapshot a few ticks old. Skip those whose source is no
+    // longer a garrison of the AI's faction holding drones, or whose target changed hands since.
+    bool isOrderStale(Game::GameEntityManager& manager, Components::Faction faction, const Components::AI::AttackPair& order) {
+        auto* sourceFaction = manager.getComponent<Components::FactionComponent>(order.source);
+        auto* sourceGarisson = manager.getComponent<Components::GarissonComponent>(order.source);
+        if (!sourceFaction || sourceFaction->faction != faction || !sourceGarisson || sourceGarisson->getDroneCount() == 0) {
+            return true;
+        }
+        auto* targetFaction = manager.getComponent<Components::FactionComponent>(order.target);
+        return !targetFaction || targetFaction->faction != order.targetFaction;
+    }
+
+    void ExecuteSystem(Game::GameEntityManager& manager, Components::Faction faction, float dt){
+        auto* aiComp = manager.getAIComponent(faction);
+        auto& commands = manager.getCommandBuffer();
+
         unsigned int attackOrdersExecuted = 0;
 
-        for(auto& [source, target, distance, cost] : aiComp->execute.finalTargets){
+        for(auto& order : aiComp->execute.finalTargets){
+            if(isOrderStale(manager, faction, order)){
+                continue;
+            }
+            auto [source, target, distance, cost, targetFaction] = order;
+
             // log_info << "Attack: "<< source << " -> " << target;
-            manager.addOrReplaceComponent<Components::AttackOrderComponent>(source, source, target);
+            commands.emplace<Components::AttackOrderComponent>(source, source, target);
             attackOrdersExecuted++;
 
             if(Config::ENABLE_DEBUG_SYMBOLS){
@@ -24,9 +45,9 @@ namespace Systems::AI {
                 aiComp->debug.pinkDebugTargets.push_back(targetTransform->getPosition());
             }
 
-            if (attackOrdersExecuted >= Config::Difficulty::AI_MAX_EXECUTIONS_PER_TURN) break;
+            if (attackOrdersExecuted >= aiComp->difficulty.maxExecutionsPerTurn) break;
         }
     }
 }
 
-#endif // AI_EXECUTE_SYSTEM_HPP
\ No newline at end of file
+#endif // AI_EXECUTE_SYSTEM_HPP
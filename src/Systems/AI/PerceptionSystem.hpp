@@ -1,125 +1,162 @@
 #ifndef AI_PERCEPTION_SYSTEM_HPP
 #define AI_PERCEPTION_SYSTEM_HPP
 
+#include <algorithm>
+#include <array>
+#include <limits>
+
 #include "Game/GameEntityManager.hpp"
+#include "Game/FactionSummary.hpp"
+#include "Game/NeighbourTable.hpp"
 
-#include "Components/GarissonComponent.hpp"
 #include "Components/FactionComponent.hpp"
+#include "Components/GarissonComponent.hpp"
+#include "Components/ShieldComponent.hpp"
+#include "Components/FactoryComponent.hpp"
+#include "Components/PowerPlantComponent.hpp"
 #include "Components/AIComponent.hpp"
 
 #include "Utils/Logger.hpp"
+#include "Config.hpp"
 
 namespace Systems::AI {
 
-    float getDistanceBetweenEntities(Game::GameEntityManager& manager, EntityID entity1, EntityID entity2){
-        auto* entity1Transform = manager.getComponent<Components::TransformComponent>(entity1);
-        auto* entity2Transform = manager.getComponent<Components::TransformComponent>(entity2);
-
-        return sqrtf(powf(entity1Transform->getPosition().x - entity2Transform->getPosition().x, 2) + powf(entity1Transform->getPosition().y - entity2Transform->getPosition().y, 2));
-    }
-    
-    void PerceptionSystem(Game::GameEntityManager& manager, float dt){
-        auto* aiComp = manager.getAIComponent();
-
-        if(!aiComp){
-            log_err << "Failed to get aiComponent";
-        }
-
-        auto entities = manager.getAllEntityIDs();
-
-        for(auto id : entities){
+    // Per garrison state the costs are computed from, read once per sweep into arrays
+    // indexed by neighbour table row
+    void sweepGarrisons(Game::GameEntityManager& manager, const Game::FactionSummary& summary, const Game::NeighbourTable& table, Components::AIPerception& perception) {
+        using Components::AIPerception;
+        using Components::FACTION_COUNT;
+
+        auto rowCount = table.getGarrisons().size();
+        perception.factions.assign(rowCount, Components::Faction::NEUTRAL);
+        perception.baseCosts.assign(rowCount, 0.f);
+        perception.regenRates.assign(rowCount, 0.f);
+        perception.kinds.assign(rowCount, Components::AIPlan::OTHER);
+        perception.ordersFrom.assign(rowCount, 0);
+        perception.ordersAgainst.assign(rowCount, 0);
+
+        // Cheapest base cost and slowest regeneration among the garrisons each faction holds
+        std::array<float, FACTION_COUNT> cheapestHeld;
+        std::array<float, FACTION_COUNT> slowestHeld;
+        cheapestHeld.fill(std::numeric_limits<float>::max());
+        slowestHeld.fill(std::numeric_limits<float>::max());
+
+        for (std::uint32_t row = 0; row < rowCount; ++row) {
+            EntityID id = table.getGarrisons()[row];
             auto* garisson = manager.getComponent<Components::GarissonComponent>(id);
+            auto* shield = manager.getComponent<Components::ShieldComponent>(id);
             auto* faction = manager.getComponent<Components::FactionComponent>(id);
-
-            // Get drone counts in garrisons for faction
-            if(garisson && garisson->getDroneCount() > 0 && faction && faction->faction != Components::Faction::NEUTRAL){
-                
-                aiComp->perception.garissonByDroneCount[id] = garisson->getDroneCount();
-
-                if( faction->faction == Components::Faction::PLAYER_1){
-                    aiComp->perception.playerTotalDrones += garisson->getDroneCount();
-                    aiComp->perception.playerGarissons.insert(id);
-                }
-                if(faction->faction == Components::Faction::PLAYER_2){
-                    aiComp->perception.aiTotalDrones += garisson->getDroneCount();
-                    aiComp->perception.aiGarissons.insert(id);
-                }
+            if (!garisson) {
+                continue;
             }
 
-            // Add in flight drones
-            auto* droneComp = manager.getComponent<Components::DroneComponent>(id);
-            if(droneComp && faction && faction->faction != Components::Faction::NEUTRAL){
-
-                if( faction->faction == Components::Faction::PLAYER_1){
-                    aiComp->perception.playerTotalDrones += 1;
-                }
-                if(faction->faction == Components::Faction::PLAYER_2){
-                    aiComp->perception.aiTotalDrones += 1;
-                }
+            perception.factions[row] = faction ? faction->faction : Components::Faction::NEUTRAL;
+            perception.baseCosts[row] = garisson->getDroneCount() + (shield ? shield->currentShield : 0.f);
+            perception.regenRates[row] = shield ? shield->regenRate : 0.f;
+            if (manager.getComponent<Components::PowerPlantComponent>(id)) {
+                perception.kinds[row] = Components::AIPlan::POWER_PLANT;
+            } else if (manager.getComponent<Components::FactoryComponent>(id)) {
+                perception.kinds[row] = Components::AIPlan::FACTORY;
             }
 
-            // Get total production rate
-            auto* factory = manager.getComponent<Components::FactoryComponent>(id);
-            if(factory && factory->droneProductionRate > 0 && faction && faction->faction != Components::Faction::NEUTRAL){
+            auto held = static_cast<std::size_t>(perception.factions[row]);
+            cheapestHeld[held] = std::min(cheapestHeld[held], perception.baseCosts[row]);
+            slowestHeld[held] = std::min(slowestHeld[held], perception.regenRates[row]);
+        }
 
-                if( faction->faction == Components::Faction::PLAYER_1){
-                    aiComp->perception.playerDroneProductionRate += factory->droneProductionRate;
-                }
-                if(faction->faction == Components::Faction::PLAYER_2){
-                    aiComp->perception.aiDroneProductionRate += factory->droneProductionRate;
+        for (std::size_t f = 0; f < FACTION_COUNT; ++f) {
+            perception.cheapestBaseCost[f] = std::numeric_limits<float>::max();
+            perception.slowestRegenRate[f] = std::numeric_limits<float>::max();
+            for (std::size_t other = 0; other < FACTION_COUNT; ++other) {
+                if (other != f) {
+                    perception.cheapestBaseCost[f] = std::min(perception.cheapestBaseCost[f], cheapestHeld[other]);
+                    perception.slowestRegenRate[f] = std::min(perception.slowestRegenRate[f], slowestHeld[other]);
                 }
             }
+        }
 
-            auto* powerPlant = manager.getComponent<Components::PowerPlantComponent>(id);
-            if(powerPlant && powerPlant->capacity > 0 && faction && faction->faction != Components::Faction::NEUTRAL){
-
-                if( faction->faction == Components::Faction::PLAYER_1){
-                    aiComp->perception.playerTotalEnergy += powerPlant->capacity;
+        // In-flight orders, marked with the faction holding them: no AI issues an order twice
+        // from the same source or against the same target
+        for (std::size_t f = 1; f < FACTION_COUNT; ++f) {
+            auto faction = static_cast<Components::Faction>(f);
+            auto bit = AIPerception::bit(faction);
+            for (const auto& [id, count] : summary.getOrderSources(faction)) {
+                auto row = table.getRow(id);
+                if (row != Game::NeighbourTable::NO_ROW) {
+                    perception.ordersFrom[row] |= bit;
                 }
-                if(faction->faction == Components::Faction::PLAYER_2){
-                    aiComp->perception.aiTotalEnergy += powerPlant->capacity;
+            }
+            for (const auto& [id, count] : summary.getOrderTargets(faction)) {
+                auto row = table.getRow(id);
+                if (row != Game::NeighbourTable::NO_ROW) {
+                    perception.ordersAgainst[row] |= bit;
                 }
             }
         }
+    }
 
-        // Compute the garissonByDistance for ai garissons
-        for(auto aiGarissonID : aiComp->perception.aiGarissons){
-
-            for(auto targetEntityID : entities){
-                auto* targetGarissonComp = manager.getComponent<Components::GarissonComponent>(targetEntityID);
-                auto* targetFaction = manager.getComponent<Components::FactionComponent>(targetEntityID);
-
-                if(!targetGarissonComp || aiGarissonID == targetEntityID){
-                    // consider garissons only
-                    continue;
-                }
+    // One sweep of the world for every AI deciding this tick. Nothing is recomputed from
+    // scratch: the faction summary recounts only entities that changed since the last sweep,
+    // and garrison distances come from the neighbour table, built once since garrisons never move.
+    // maxDistance: longest attack reach of any AI, so the table is not rebuilt as they take turns
+    Components::AIPerception& PerceptionSystem(Game::GameEntityManager& manager, float maxDistance, float dt){
+        auto& perception = manager.getAIPerception();
+        const auto& summary = manager.refreshFactionSummary();
+        const auto& table = manager.getNeighbourTable(maxDistance);
+        perception.summary = &summary;
+        perception.neighbours = &table;
+
+        for (std::size_t f = 0; f < Components::FACTION_COUNT; ++f) {
+            const auto& totals = summary.getTotals(static_cast<Components::Faction>(f));
+            perception.totalDrones[f] = totals.drones;
+            perception.totalEnergy[f] = totals.energy;
+            perception.droneProductionRate[f] = totals.production;
+        }
 
-                if(targetFaction && targetFaction->faction == Components::Faction::PLAYER_2){
-                    // consider only player 1 and neutral only
-                    continue;
-                }
+        sweepGarrisons(manager, summary, table, perception);
+        return perception;
+    }
 
-                auto distance = getDistanceBetweenEntities(manager, aiGarissonID, targetEntityID);
-                aiComp->perception.garissonsByDistance[aiGarissonID][distance] = targetEntityID;
-                // log_info << "Garisson:" << aiGarissonID << " -> " << targetEntityID << " : " << distance;
-            }
+    // Copies what one AI needs from the sweep into plan, which PlanSystem then works on alone
+    void snapshotPlan(const Components::AIPerception& perception, const Components::AIComponent& ai, Components::AIPlan& plan) {
+        const auto& difficulty = ai.difficulty;
+        auto f = static_cast<std::size_t>(ai.faction);
+
+        plan.reset();
+        plan.faction = ai.faction;
+        plan.neighbours = perception.neighbours;
+        plan.maxOrders = difficulty.maxExecutionsPerTurn;
+        plan.maxDistance = difficulty.maxDistanceToAttack;
+        plan.stepsPerTick = difficulty.planStepsPerTick;
+        plan.deadline = difficulty.decisionIntervalSec;
+        plan.aiTotalDrones = perception.totalDrones[f];
+        plan.aiTotalEnergy = perception.totalEnergy[f];
+        plan.cheapestBaseCost = perception.cheapestBaseCost[f];
+        plan.slowestRegenRate = perception.slowestRegenRate[f];
+
+        plan.factions = perception.factions;
+        plan.baseCosts = perception.baseCosts;
+        plan.regenRates = perception.regenRates;
+        plan.kinds = perception.kinds;
+
+        auto rowCount = perception.factions.size();
+        auto bit = Components::AIPerception::bit(ai.faction);
+        plan.busySources.resize(rowCount);
+        plan.busyTargets.resize(rowCount);
+        for (std::size_t row = 0; row < rowCount; ++row) {
+            plan.busySources[row] = (perception.ordersFrom[row] & bit) != 0;
+            plan.busyTargets[row] = (perception.ordersAgainst[row] & bit) != 0;
         }
 
-        // Get all attack orders
-        for(auto id : entities){
-            auto *attackOrder = manager.getComponent<Components::AttackOrderComponent>(id);
-            auto* faction = manager.getComponent<Components::FactionComponent>(id);
-            if(attackOrder && faction){
-                if(faction->faction == Components::Faction::PLAYER_1){
-                    aiComp->perception.playerAttackOrders.insert({attackOrder->origin, attackOrder->target,0.f ,0.f});
-                }
-                if(faction->faction == Components::Faction::PLAYER_2){
-                    aiComp->perception.aiAttackOrders.insert({attackOrder->origin, attackOrder->target, 0.f, 0.f});
-                }
+        const auto& table = *perception.neighbours;
+        for (auto id : perception.summary->getGarrisons(ai.faction)) {
+            auto row = table.getRow(id);
+            if (row != Game::NeighbourTable::NO_ROW) {
+                plan.origins.push_back(id, row, static_cast<float>(perception.summary->getGarrisonDrones(id)));
             }
         }
     }
 }
 
 
-#endif
\ No newline at end of file
+#endif
@@ -1,11 +1,17 @@
 #ifndef AI_PLAN_SYSTEM_HPP
 #define AI_PLAN_SYSTEM_HPP
 
-#include <map>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <vector>
 
-#include "Game/GameEntityManager.hpp"
+#include "Game/NeighbourTable.hpp"
 
-#include "Components/GarissonComponent.hpp"
+#include "Components/FactionComponent.hpp"
+#include "Components/AIComponent.hpp"
 
 #include "Utils/Logger.hpp"
 #include "Utils/Random.hpp"
@@ -22,57 +28,40 @@ namespace Systems::AI {
         DISTANCE = 5,
     };
 
-    float computeAttackCost(Game::GameEntityManager& manager, EntityID targetEntityID, float distance) {
-        // returns how many drones it would take to conquer the target
-
-        auto* targetGarisson = manager.getComponent<Components::GarissonComponent>(targetEntityID);
-        auto* targetShield = manager.getComponent<Components::ShieldComponent>(targetEntityID);
-
-        // compute drone cost
-        auto droneCost = targetGarisson->getDroneCount();
-        
-        // compute shield cost
-        auto currentShield = targetShield->currentShield;
-
-        // compute shield regen cost (for drone travel time)
+    // Drones it would take to conquer a target: the drones stationed there, its shield,
+    // and what the shield regenerates while the attack is in flight. baseCost is drones plus shield.
+    inline float computeAttackCost(float baseCost, float regenRate, float distance) {
         auto timeToReachTarget = distance / Config::DRONE_SPEED;
-        auto shieldRegenRate = targetShield->regenRate;
-        auto shieldRegenCost = timeToReachTarget * shieldRegenRate;
-
-        return droneCost + currentShield + shieldRegenCost;
+        return baseCost + timeToReachTarget * regenRate;
     }
 
-    std::unordered_map<Strategy, float> computeStrategyPriorities(Game::GameEntityManager& manager) {
-        std::unordered_map<Strategy, float> priorities = {
-            {Strategy::ENERGY, 0.f},
-            {Strategy::PRODUCTION, 0.f},
-            {Strategy::DEFEND, 0.f},
-            {Strategy::ATTACK, 0.f},
-        };
-        
-        auto* aiComp = manager.getAIComponent();
+    constexpr std::size_t STRATEGY_COUNT = 6;
+
+    // Indexed by Strategy
+    std::array<float, STRATEGY_COUNT> computeStrategyPriorities(const Components::AIPlan& plan) {
+        std::array<float, STRATEGY_COUNT> priorities{};
 
         // Compute total droens in 5 seconds if no attack planned
         float totalDrones = 0.f;
-        totalDrones += aiComp->perception.aiTotalDrones;
-        // totalDrones += aiComp->perception.aiDroneProductionRate * 5.f;
-        float aiTotalEnergy = aiComp->perception.aiTotalEnergy;
+        totalDrones += plan.aiTotalDrones;
+        // totalDrones += aiDroneProductionRate * 5.f;
+        float aiTotalEnergy = plan.aiTotalEnergy;
         float droneToEnergyRatio = totalDrones / aiTotalEnergy;
 
         // log_info << "droneEnergyRatio: " << droneToEnergyRatio << ", totalDrones: " << totalDrones << ", aiTotalEnergy: " << aiTotalEnergy;
 
         if(aiTotalEnergy < 20){
             //  log_info << "energy < 21, ENERGY";
-            priorities[Strategy::ENERGY] = 1.f;
+            priorities[static_cast<std::size_t>(Strategy::ENERGY)] = 1.f;
         }else if(droneToEnergyRatio < 0.5f){
             //  log_info << "droneToEnergyRatio < 0.5, PRODUCTION, " << droneToEnergyRatio;
-            priorities[Strategy::PRODUCTION] = 1.f;
+            priorities[static_cast<std::size_t>(Strategy::PRODUCTION)] = 1.f;
         }else if(droneToEnergyRatio > 0.9f){
-            priorities[Strategy::ENERGY] = 1.f;
+            priorities[static_cast<std::size_t>(Strategy::ENERGY)] = 1.f;
         }
         else{
             // log_info << "DISTANCE";
-            priorities[Strategy::DISTANCE] = 1.f;
+            priorities[static_cast<std::size_t>(Strategy::DISTANCE)] = 1.f;
         }
 
         // TODO: add Attack/defend strategy
@@ -104,163 +93,225 @@ namespace Systems::AI {
         };
     }
 
-    void PlanSystem(Game::GameEntityManager& manager, float dt){
-        auto* aiComp = manager.getAIComponent();
+    enum class Visit { NEXT, DROP_ORIGIN, STOP };
+
+    // Walks the neighbours of every origin in (distance, origin, target) order, the order the
+    // old ordered sets held every candidate in, but lazily: each origin sits in a heap keyed by
+    // its next neighbour, so rows are only read as far as the walk gets before visit() stops it.
+    // visit(origin, neighbour) returns NEXT to go on, DROP_ORIGIN to skip the rest of that origin's row.
+    // Resumable: takes a step per origin put on the heap and per neighbour visited, and returns
+    // false when steps run out first. Starts with plan.cursor at 0 and an empty heap.
+    template<typename VisitFn>
+    bool walkNearestFirst(const Game::NeighbourTable& table, Components::AIPlan& plan, std::size_t& steps, VisitFn visit) {
+        auto& origins = plan.origins;
+        auto& heap = plan.heap;
+
+        auto next = [&](std::uint32_t origin) -> const Game::NeighbourTable::Neighbour& {
+            return table.getNeighbours(origins.rows[origin]).begin()[origins.cursors[origin]];
+        };
+        // std heaps keep the largest on top; no two entries compare equal, so the walk
+        // does not depend on how the heap was built
+        auto further = [&](std::uint32_t a, std::uint32_t b) {
+            const auto& na = next(a);
+            const auto& nb = next(b);
+            if (na.distance != nb.distance) {
+                return na.distance > nb.distance;
+            }
+            return std::tie(origins.ids[a], na.id) > std::tie(origins.ids[b], nb.id);
+        };
 
-        if(!aiComp){
-            log_err << "Failed to get aiComponent";
+        for (; plan.cursor < origins.size() && steps > 0; ++plan.cursor, --steps) {
+            auto origin = plan.cursor;
+            origins.cursors[origin] = 0;
+            if (origins.ends[origin] > 0) {
+                heap.push_back(origin);
+                std::push_heap(heap.begin(), heap.end(), further);
+            }
+        }
+        if (plan.cursor < origins.size()) {
+            return false;
         }
 
-        // Declare local vars
-        std::set<Components::AI::AttackPair, Components::AI::ComparatorPairByDistance> potentialSuccesfulSingleAttackTargetsByDistance; 
-        std::set<Components::AI::AttackPair, Components::AI::ComparatorPairByDistance> potentialFailedSingleAttackTargetsByDistance;
-        std::set<Components::AI::AttackPair, Components::AI::ComparatorPairByCost> potentialFailedSingleAttackTargetsByCost;
-
-        // Strategy: need energy or more factories?
-        auto priorities = computeStrategyPriorities(manager);
-        auto strategy = std::max_element(priorities.begin(), priorities.end(), [](const std::pair<Strategy, float>& a, const std::pair<Strategy, float>& b) { return a.second < b.second; })->first;
-
-        // logStrategy(strategy);
-
-        // Plan: Check if any single garisson can conquer an adjacent target and save it
-        // if not, save it to potential failed attacks
-        for(auto it = aiComp->perception.garissonsByDistance.begin(); it != aiComp->perception.garissonsByDistance.end(); it++){
-            auto originGarissonID = it->first;
-
-            for(auto [distance, targetEntityID] : it->second){
-                float costForSuccesfulAttack = computeAttackCost(manager, targetEntityID, distance);
-                costForSuccesfulAttack += 1.f; // add some buffer
-
-                auto droneCountAtThisGarisson = aiComp->perception.garissonByDroneCount.at(originGarissonID);
+        while (!heap.empty()) {
+            if (steps == 0) {
+                return false;
+            }
+            --steps;
 
-                auto* originTransform = manager.getComponent<Components::TransformComponent>(originGarissonID);
-                auto* targetTransform = manager.getComponent<Components::TransformComponent>(targetEntityID);
+            std::pop_heap(heap.begin(), heap.end(), further);
+            auto origin = heap.back();
 
-                auto pair = Components::AI::AttackPair(originGarissonID, targetEntityID, distance, costForSuccesfulAttack);
-                if(droneCountAtThisGarisson > costForSuccesfulAttack){
-                    // log_info << "Can conquer " << targetEntityID << " from " << originGarissonID << ", dist: " << distance;
-                    potentialSuccesfulSingleAttackTargetsByDistance.insert(pair);
-                }else{
-                    potentialFailedSingleAttackTargetsByDistance.insert(pair);
-                    potentialFailedSingleAttackTargetsByCost.insert(pair);
-                }
+            auto result = visit(origin, next(origin));
+            if (result == Visit::STOP) {
+                break;
+            }
+            if (result == Visit::DROP_ORIGIN || ++origins.cursors[origin] == origins.ends[origin]) {
+                heap.pop_back();
+                continue;
             }
+            std::push_heap(heap.begin(), heap.end(), further);
         }
+        heap.clear();
+        return true;
+    }
 
-        bool submittedAnAttackOrder = false;
-        if(!potentialSuccesfulSingleAttackTargetsByDistance.empty()){
-            // logStrategy(strategy);
-            // implement the strategy 
-            // scan through potential targets and chooe a target
-            for(auto& pair : potentialSuccesfulSingleAttackTargetsByDistance){
-                auto [source, target, distance, cost] = pair;
-
-                // log_info << "dist: " << distance << " source: " << source << " target: " << target;
-
-                auto* targetPowerPlantComp = manager.getComponent<Components::PowerPlantComponent>(target);
-                auto* targetFactoryComp = manager.getComponent<Components::FactoryComponent>(target);
+    // Plans one decision from the snapshot PerceptionSystem took into plan; the orders land in plan.orders.
+    // Touches nothing but plan, so it may run on any thread.
+    // Resumable: does at most steps units of work (an origin or a candidate target each) and returns
+    // whether the decision is complete. Orders are planned nearest first and never revised, so the
+    // orders so far are the start of the complete plan and can be carried out if planning stops early.
+    bool PlanSystem(Components::AIPlan& plan, std::size_t steps){
+        using Stage = Components::AIPlan::Stage;
+
+        auto& origins = plan.origins;
+        auto& orders = plan.orders;
+        const auto& table = *plan.neighbours;
+        const std::size_t maxOrders = plan.maxOrders;
+
+        // Cost of an attack on a garisson of another faction, NaN (never affordable) for anything else
+        auto attackCost = [&](const Game::NeighbourTable::Neighbour& target){
+            if(plan.factions[target.row] == plan.faction){
+                return std::numeric_limits<float>::quiet_NaN();
+            }
+            return computeAttackCost(plan.baseCosts[target.row], plan.regenRates[target.row], target.distance) + 1.f; // add some buffer
+        };
+        // Cheapest conceivable attack at a distance: base cost and regeneration of the cheapest targets.
+        // An origin holding fewer drones cannot win anything that far away or further.
+        auto outOfReach = [&](std::uint32_t origin, const Game::NeighbourTable::Neighbour& target){
+            return origins.drones[origin] <= computeAttackCost(plan.cheapestBaseCost, plan.slowestRegenRate, target.distance) + 1.f;
+        };
+        auto issue = [&](std::uint32_t origin, const Game::NeighbourTable::Neighbour& target, float cost){
+            orders.emplace_back(origins.ids[origin], target.id, target.distance, cost, plan.factions[target.row]);
+            plan.busySources[origins.rows[origin]] = 1;
+            plan.busyTargets[target.row] = 1;
+        };
+        auto enter = [&](Stage stage){
+            plan.stage = stage;
+            plan.cursor = 0;
+        };
+        // Later stages only run while nothing has been planned
+        auto afterFallback = [&](){
+            enter(orders.empty() && plan.closestSource != entt::null ? Stage::CONSOLIDATE : Stage::DONE);
+        };
+        auto afterStrategy = [&](){
+            if(orders.empty() && maxOrders > 0){
+                enter(Stage::FALLBACK);
+            }else{
+                afterFallback();
+            }
+        };
 
-                // Explicit local variable (macOS compiler workaround)
-                EntityID targetID = target; 
+        while(steps > 0 && plan.stage != Stage::DONE){
+            switch(plan.stage){
+            case Stage::START: {
+                // Strategy: need energy or more factories?
+                auto priorities = computeStrategyPriorities(plan);
+                auto strategy = static_cast<Strategy>(std::max_element(priorities.begin(), priorities.end()) - priorities.begin());
+                // logStrategy(strategy);
+
+                plan.wantedKind = strategy == Strategy::ENERGY ? Components::AIPlan::POWER_PLANT
+                                : strategy == Strategy::PRODUCTION ? Components::AIPlan::FACTORY
+                                : Components::AIPlan::OTHER;
+                enter(Stage::REACH);
+                break;
+            }
 
-                // If orders to this target are already issued, don't issue them again
-                auto found_target = std::find_if(
-                    aiComp->perception.aiAttackOrders.begin(),
-                    aiComp->perception.aiAttackOrders.end(),
-                    [targetID](const Components::AI::AttackPair& pair) {
-                        return pair.target == targetID;
+            case Stage::REACH:
+                // Nearest first, and nothing further away is ever attacked; also finds the
+                // closest target of any origin, the consolidation point if no attack can be won
+                for(; plan.cursor < origins.size() && steps > 0; ++plan.cursor, --steps){
+                    auto origin = plan.cursor;
+                    auto neighbours = table.getNeighbours(origins.rows[origin]);
+                    const auto* inReach = std::upper_bound(neighbours.begin(), neighbours.end(), plan.maxDistance,
+                        [](float distance, const Game::NeighbourTable::Neighbour& neighbour){ return distance < neighbour.distance; });
+                    origins.ends[origin] = static_cast<std::uint32_t>(inReach - neighbours.begin());
+
+                    for(const auto* target = neighbours.begin(); target != inReach; ++target){
+                        if(plan.factions[target->row] == plan.faction){
+                            continue;
+                        }
+                        if(plan.closestSource == entt::null || target->distance < plan.closestDistance){
+                            plan.closestSource = origins.ids[origin];
+                            plan.closestDistance = target->distance;
+                            plan.closestCost = computeAttackCost(plan.baseCosts[target->row], plan.regenRates[target->row], target->distance) + 1.f;
+                        }
+                        break;
                     }
-                );
-                if(found_target != aiComp->perception.aiAttackOrders.end()){
-                    // log_info << "Already issued attack orders to this target";
-                    continue;
                 }
-
-                // If orders from this source are already issued, don't issue them again
-                EntityID sourceID = source;
-                auto found_source = std::find_if(
-                    aiComp->perception.aiAttackOrders.begin(),
-                    aiComp->perception.aiAttackOrders.end(),
-                    [sourceID](const Components::AI::AttackPair& pair) {
-                        return pair.source == sourceID;
+                if(plan.cursor == origins.size()){
+                    if(plan.wantedKind != Components::AIPlan::OTHER && maxOrders > 0){
+                        enter(Stage::STRATEGY);
+                    }else{
+                        afterStrategy();
                     }
-                );
-                if(found_source != aiComp->perception.aiAttackOrders.end()){
-                    // log_info << "Already issued attack orders from this source";
-                    continue;
                 }
+                break;
 
-                // If the distance between the source and target is too large, don't attack
-                if(distance > Config::Difficulty::AI_MAX_DISTANCE_TO_ATTACK){
-                    // log_info << "Distance between source and target is too large, skipping";
-                    continue;
-                }
-
-                if(targetPowerPlantComp && strategy == Strategy::ENERGY){
-                    // issue orders to attack
-                    aiComp->execute.finalTargets.push_back(pair);
-                    aiComp->perception.aiAttackOrders.insert(pair);
-                    submittedAnAttackOrder = true;
-                    // log_info << "Attacking power plant (source, target, distance, cost):" << source << ", " << target << ", " << distance << ", " << cost;
-
-                }if(targetFactoryComp && strategy == Strategy::PRODUCTION){
-                    // issue orders to attack
-                    aiComp->execute.finalTargets.push_back(pair);
-                    aiComp->perception.aiAttackOrders.insert(pair);
-                    submittedAnAttackOrder = true;
-                    // log_info << "Attacking factory (source, target, distance, cost):" << source << ", " << target << ", " << distance << ", " << cost;
-
+            case Stage::STRATEGY: {
+                // Implement the strategy: attack the closest targets of the wanted kind that a single
+                // garisson can conquer, one order per source and per target
+                bool done = walkNearestFirst(table, plan, steps, [&](std::uint32_t origin, const Game::NeighbourTable::Neighbour& target){
+                    // If orders from this source are already issued, don't issue them again
+                    if(plan.busySources[origins.rows[origin]] || outOfReach(origin, target)){
+                        return Visit::DROP_ORIGIN;
+                    }
+                    // If orders to this target are already issued, don't issue them again
+                    if(plan.kinds[target.row] != plan.wantedKind || plan.busyTargets[target.row]){
+                        return Visit::NEXT;
+                    }
+                    float cost = attackCost(target);
+                    if(origins.drones[origin] > cost){
+                        issue(origin, target, cost);
+                        return orders.size() < maxOrders ? Visit::DROP_ORIGIN : Visit::STOP;
+                    }
+                    return Visit::NEXT;
+                });
+                if(done){
+                    afterStrategy();
                 }
+                break;
             }
 
-            // Was not able to submit an attack order acording to the desired strategy
-            // Issue orders that can be submitted
-            if(submittedAnAttackOrder == false){
-            
-                for(auto& potentialSuccesfulSingleAttackTargetsByDistance : potentialSuccesfulSingleAttackTargetsByDistance){
-                    auto [source, target, distance, cost] = potentialSuccesfulSingleAttackTargetsByDistance;
-                    // log_info << "MapData (source,target,distance,cost): " << source << ", " << target << ", " << distance << ", " << cost;
-                }
-                for(auto& pair : potentialSuccesfulSingleAttackTargetsByDistance){
-                    auto [source, target, distance, cost] = pair;
-                    auto* garissonComp = manager.getComponent<Components::GarissonComponent>(target);
-
-                    if(distance > Config::Difficulty::AI_MAX_DISTANCE_TO_ATTACK){
-                        continue;
+            case Stage::FALLBACK: {
+                // Was not able to submit an attack order acording to the desired strategy:
+                // issue the closest attacks that can be won, as many as get executed
+                bool done = walkNearestFirst(table, plan, steps, [&](std::uint32_t origin, const Game::NeighbourTable::Neighbour& target){
+                    if(outOfReach(origin, target)){
+                        return Visit::DROP_ORIGIN;
                     }
-
-                    if(garissonComp){
-                        // issue orders to attack
-                        aiComp->execute.finalTargets.push_back(pair);
-                        aiComp->perception.aiAttackOrders.insert(pair);
-                        submittedAnAttackOrder = true;
-                        // log_info << "Attacking closest target (source, target, distance, cost):" << source << ", " << target << ", " << distance << ", " << cost;
+                    float cost = attackCost(target);
+                    if(origins.drones[origin] > cost){
+                        issue(origin, target, cost);
+                        return orders.size() < maxOrders ? Visit::NEXT : Visit::STOP;
                     }
+                    return Visit::NEXT;
+                });
+                if(done){
+                    afterFallback();
                 }
+                break;
             }
-        }
 
-        // Plan: If no garisson alone can conquer adjacent targets, compute collective plan
-        if (submittedAnAttackOrder == false) {
-            // 1. Consolidate into the closest ai garisson 
+            case Stage::CONSOLIDATE:
+                // Plan: If no garisson alone can conquer adjacent targets,
+                // consolidate into the garisson closest to a target
+                for(; plan.cursor < origins.size() && steps > 0; ++plan.cursor, --steps){
+                    if(orders.size() >= maxOrders) break;
+                    auto garisson = origins.ids[plan.cursor];
+                    if(garisson == plan.closestSource) continue; // cannot consolidate with self
 
-            for(auto& pair : potentialFailedSingleAttackTargetsByDistance){
-                auto [consolidationSource, target, distance, cost] = pair;
-
-                if(distance > Config::Difficulty::AI_MAX_DISTANCE_TO_ATTACK) continue;
-
-                // log_info << "Consolidation target: " << consolidationSource;
-
-                for(auto& garisson : aiComp->perception.aiGarissons){
-                    if(garisson == consolidationSource) continue; // cannot consolidate with self
-                    
-                    auto consolidatePair = Components::AI::AttackPair(garisson, consolidationSource, distance, cost);
-                    aiComp->execute.finalTargets.push_back(consolidatePair);
-                    // log_info << "consolidating (source, target, distance, cost):" << consolidatePair.source << ", " << consolidatePair.target << ", " << consolidatePair.distance << ", " << consolidatePair.cost;
+                    orders.emplace_back(garisson, plan.closestSource, plan.closestDistance, plan.closestCost, plan.faction);
                 }
+                if(plan.cursor == origins.size() || orders.size() >= maxOrders){
+                    enter(Stage::DONE);
+                }
+                break;
+
+            case Stage::DONE:
                 break;
             }
         }
+        return plan.stage == Stage::DONE;
     }
 }
 
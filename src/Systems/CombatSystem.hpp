@@ -9,15 +9,69 @@
 #include "Components/MoveComponent.hpp"
 #include "Components/AttackOrderComponent.hpp"
 #include "Components/GarissonComponent.hpp"
+#include "Components/FleetComponent.hpp"
+#include "Components/FlightComponent.hpp"
 
 #include "Game/Builder.hpp"
 
 #include "Utils/Logger.hpp"
 
 namespace Systems {
-        void CombatSystem(Game::GameEntityManager& manager, float dt) {
 
-            std::vector<EntityID> toRemoveEntities;
+        // A single drone reaches its target: park, hit the shield, trade drones or capture
+        void resolveDroneArrival(Game::GameEntityManager& manager, Components::Faction attackingFaction, EntityID targetEntity) {
+            auto* targetFaction = manager.getComponent<Components::FactionComponent>(targetEntity);
+            auto* targetGarisson = manager.getComponent<Components::GarissonComponent>(targetEntity);
+            auto* targetShield = manager.getComponent<Components::ShieldComponent>(targetEntity);
+
+            if(!targetShield){
+                log_err << "target entity has no shield component which is required to be attacked";
+                return;
+            }
+
+            if (!targetGarisson || !targetFaction) {
+                return;
+            }
+
+            auto defendingFaction = targetFaction->faction;
+            auto* gameState = manager.getGameStateComponent();
+
+            if(attackingFaction == defendingFaction){
+                // Same faction, park drones
+                manager.patchComponent<Components::GarissonComponent>(targetEntity, [](auto& garisson){ garisson.incrementDroneCount(); });
+                return;
+            }
+                
+            // If shield is positive, hit shield and update its value
+            if(targetShield->getShield() > 1.f){
+                targetShield->decrementShield();
+            }else{
+                targetShield->setShield(0.f); 
+            }
+                
+            if(targetShield->getShield() > 0.f){
+                // Shield was hit but still up, attacking player loses drones
+                gameState->playerDrones[attackingFaction]--;
+
+            }else if(targetGarisson->getDroneCount() > 0){
+                // Shield is down
+                // Different faction has drones parked
+                // Kill drones
+                manager.patchComponent<Components::GarissonComponent>(targetEntity, [](auto& garisson){ garisson.decrementDroneCount(); });
+
+                // both players lose drones
+                gameState->playerDrones[attackingFaction]--;
+                gameState->playerDrones[defendingFaction]--;
+            }else{
+                // Different Faction, no shield, no drones, switch factions
+                manager.patchComponent<Components::FactionComponent>(targetEntity, [&](auto& faction){ faction.faction = attackingFaction; });
+                manager.patchComponent<Components::GarissonComponent>(targetEntity, [](auto& garisson){ garisson.incrementDroneCount(); });
+            }
+        }
+
+        // Fleets are created and released through the command buffer, at the next flush
+        void CombatSystem(Game::GameEntityManager& manager, float dt) {
+            auto& commands = manager.getCommandBuffer();
 
             for(auto&& [id, attackOrder, originGarisson, faction] : manager.view<
                 Components::AttackOrderComponent, 
@@ -43,99 +97,41 @@ namespace Systems {
 
                 auto dronesUsedForAttack = originGarisson.getDroneCount() - 1;
 
-                for(auto i=0; i < dronesUsedForAttack; i++){
-                    // Creating drones
-                    EntityID droneID = Game::createDrone(manager, std::to_string(i), faction.faction);
-                    manager.addOrReplaceComponent<Components::AttackOrderComponent>(droneID, attackOrder.origin, attackOrder.target);
-
-                        sf::Vector2f originPosition = manager.getComponent<Components::TransformComponent>(id)->transform.getPosition();
-                        int spread = 25 + (dronesUsedForAttack * 5);
-                        spread = std::min(spread, 75);
-                        sf::Vector2f randomOffset = sf::Vector2f(
-                            rand() % (2 * spread) - spread,
-                            rand() % (2 * spread) - spread
-                        );
-
-                        auto* droneTransform = manager.getComponent<Components::TransformComponent>(droneID);
-                        droneTransform->transform.setPosition(originPosition + randomOffset);
-
-                        auto* droneMove = manager.getComponent<Components::MoveComponent>(droneID);
-                        droneMove->targetPosition = manager.getComponent<Components::TransformComponent>(targetEntityID)->transform.getPosition();
-                        droneMove->moveToTarget = true;
-                }
-                originGarisson.setDroneCount(1);
+                // One fleet entity carries all launched drones
+                sf::Vector2f originPosition = manager.getComponent<Components::TransformComponent>(id)->transform.getPosition();
+                sf::Vector2f targetPosition = manager.getComponent<Components::TransformComponent>(targetEntityID)->transform.getPosition();
+                auto launchingFaction = faction.faction;
+                EntityID origin = attackOrder.origin;
+                commands.create([=](Game::GameEntityManager& manager){
+                    Game::createFleet(manager, launchingFaction, origin, targetEntityID, dronesUsedForAttack, originPosition, targetPosition);
+                });
+
+                manager.patchComponent<Components::GarissonComponent>(id, [](auto& garisson){ garisson.setDroneCount(1); });
                 attackOrder.isActivated = false;
             }
 
-            for(auto&& [id, drone, faction, attackOrder, move] : manager.view<
-                Components::DroneComponent, 
-                Components::FactionComponent,
-                Components::AttackOrderComponent,
-                Components::MoveComponent>().each()){                    
-                
-                if(move.moveToTarget == false){
-                    // Drone Reached destination
-
-                    EntityID originEntity = attackOrder.origin;
-                    EntityID targetEntity = attackOrder.target;
-                        
-                    auto* targetFaction = manager.getComponent<Components::FactionComponent>(targetEntity);
-                    auto* targetGarisson = manager.getComponent<Components::GarissonComponent>(targetEntity);
-                    auto* targetShield = manager.getComponent<Components::ShieldComponent>(targetEntity);
-        
-                    if(!targetShield){
-                        log_err << "target entity has no shield component which is required to be attacked";
-                    }
-
-                    if (targetGarisson && targetFaction) {
-
-                        auto attackingFaction = faction.faction;
-                        auto defendingFaction = targetFaction->faction;
-
-                        // No matter what, drone entity needs to be removed
-                        toRemoveEntities.push_back(id);
-
-                        auto* gameState = manager.getGameStateComponent();
-
-                        if(attackingFaction == defendingFaction){
-                            // Same faction, park drones
-                            targetGarisson->incrementDroneCount();
-                            continue; 
-                        }
-                            
-                        // If shield is positive, hit shield and update its value
-                        if(targetShield->getShield() > 1.f){
-                            targetShield->decrementShield();
-                        }else{
-                            targetShield->setShield(0.f); 
-                        }
-                            
-                        if(targetShield->getShield() > 0.f){
-                            // Shield was hit but still up, attacking player loses drones
-                            gameState->playerDrones[attackingFaction]--;
-
-                        }else if(targetGarisson->getDroneCount() > 0){
-                            // Shield is down
-                            // Different faction has drones parked
-                            // Kill drones
-                            targetGarisson->decrementDroneCount();
-
-                            // both players lose drones
-                            gameState->playerDrones[attackingFaction]--;
-                            gameState->playerDrones[defendingFaction]--;
-                        }else{
-                            // Different Faction, no shield, no drones, switch factions
-                            targetFaction->faction = attackingFaction;
-                            targetGarisson->incrementDroneCount();
-                        }
-                    }
+            // Only fleets due this tick are touched, fleets in flight cost nothing
+            double now = manager.getSimulationTime();
+            Game::GameEntityManager::ScheduledArrival arrival;
+            while (manager.popArrival(now, arrival)) {
+                auto* flight = manager.getComponent<Components::FlightComponent>(arrival.id);
+                if (!flight || flight->arrivalTime != arrival.time) {
+                    // Fleet was removed (and maybe reused) before it arrived
+                    continue;
+                }
+                auto* fleet = manager.getComponent<Components::FleetComponent>(arrival.id);
+                auto* faction = manager.getComponent<Components::FactionComponent>(arrival.id);
+                auto* attackOrder = manager.getComponent<Components::AttackOrderComponent>(arrival.id);
+
+                // Fleet reached destination, every drone resolves on its own
+                for(unsigned int i = 0; i < fleet->droneCount; i++){
+                    resolveDroneArrival(manager, faction->faction, attackOrder->target);
                 }
-            }
 
-            for (auto id : toRemoveEntities) {
-                manager.removeEntity(id);
+                // No matter what, fleet entity goes back to the pool
+                Game::destroyFleet(commands, arrival.id);
             }
         }
 }
 
-#endif // COMBAT_SYSTEM_HPP
\ No newline at end of file
+#endif // COMBAT_SYSTEM_HPP
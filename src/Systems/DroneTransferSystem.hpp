@@ -9,6 +9,7 @@ namespace Systems {
 
 
     void DroneTransferSystem(Game::GameEntityManager& manager, float dt) {
+        auto& commands = manager.getCommandBuffer();
 
         for(auto&& [id, transfer, faction, garisson, attackOrder] : manager.view<
             Components::DroneTransferComponent,
@@ -18,14 +19,19 @@ namespace Systems {
                 
             if(faction.faction != transfer.faction){
                 // if the factions changed, remove the order
-                manager.removeComponent<Components::DroneTransferComponent>(id);
+                commands.remove<Components::DroneTransferComponent>(id);
             }
 
             if(garisson.getDroneCount() > 1){
                 // log_info << "enable attack order";
                 attackOrder.isActivated = true;
-                attackOrder.origin = transfer.source;
-                attackOrder.target = transfer.target;
+                if(attackOrder.origin != transfer.source || attackOrder.target != transfer.target){
+                    // Patched so the AI's faction summary sees the new order
+                    manager.patchComponent<Components::AttackOrderComponent>(id, [&](auto& order){
+                        order.origin = transfer.source;
+                        order.target = transfer.target;
+                    });
+                }
             }
         }
     }
@@ -1,40 +1,33 @@
 #ifndef WINNING_CONDITIONS_SYSTEM_HPP
 #define WINNING_CONDITIONS_SYSTEM_HPP
 
-#include <unordered_map>
+#include <array>
 #include "Game/GameEntityManager.hpp"
 #include "Components/FactionComponent.hpp"
 
 namespace Systems {
 
+    // Scheduled every GAME_STATE_CHECK_INTERVAL_SEC
+    // The game is over once at most one player has units left on the map, and that player wins
     void GameStateSystem(Game::GameEntityManager& manager, float dt) {
+        auto* gameState = manager.getGameStateComponent();
 
-        static float timer = 0.f;
-        // Run this check every 5 seconds
-        if(timer < 5.f){
-            timer += dt;
-            return;
-        }
-        timer = 0.f;
-
-        std::unordered_map<Components::Faction, unsigned int> units;
-
-        // check if both players have units on the map
+        std::array<unsigned int, Components::FACTION_COUNT> units{};
         for(auto&& [id, faction] : manager.view<Components::FactionComponent>().each()) {
-            units[faction.faction] += 1;
+            units[static_cast<std::size_t>(faction.faction)] += 1;
         }
-            
-        if(units[Components::Faction::PLAYER_1] == 0) {
-            // Player1 has lost
-            auto* gameState = manager.getGameStateComponent();
-            gameState->winner = Components::Faction::PLAYER_2;
-            gameState->isGameOver = true;
+
+        unsigned int playersLeft = 0;
+        auto survivor = Components::Faction::NEUTRAL;
+        for(unsigned int player = 1; player <= gameState->playerCount; ++player) {
+            if(units[player] > 0) {
+                playersLeft++;
+                survivor = static_cast<Components::Faction>(player);
+            }
         }
 
-        if (units[Components::Faction::PLAYER_2] == 0) {
-            // Player2 has lost
-            auto* gameState = manager.getGameStateComponent();
-            gameState->winner = Components::Faction::PLAYER_1;
+        if(playersLeft <= 1) {
+            gameState->winner = survivor;
             gameState->isGameOver = true;
         }
     }
@@ -6,17 +6,19 @@
 #include <cstdio>
 
 
-#include "Components/HoverComponent.hpp"
-#include "Components/TagComponent.hpp"
-#include "Components/GarissonComponent.hpp"
 #include "Components/FactionComponent.hpp"
+#include "Components/DebugOverlayComponent.hpp"
+
+#include "Game/RenderSnapshot.hpp"
+#include "Game/InputCommand.hpp"
 
 #include "Config.hpp"
 #include <TGUI/TGUI.hpp>
 #include <TGUI/Backend/SFML-Graphics.hpp>
 
 namespace Systems {
-    void HudSystem(Game::GameEntityManager& manager, tgui::Gui& gui) {
+    // Window thread: shows the latest snapshot, settings go back to the simulation as input commands
+    void HudSystem(const Game::RenderSnapshot& snapshot, const Components::DebugOverlayComponent& debug, tgui::Gui& gui, Game::InputQueue& input) {
         static tgui::Theme::Ptr theme = Resource::ResourceManager::getInstance().getTheme(Resource::Paths::DARK_THEME);
 
         // GUI widgets declarations
@@ -84,26 +86,14 @@ namespace Systems {
             difficultyComboBox->setSelectedItem("Medium");
 
             // Handle selection change
-            difficultyComboBox->onItemSelect([&](const tgui::String& item){
+            difficultyComboBox->onItemSelect([&input](const tgui::String& item){
                 auto difficulty = item.toStdString();
                 log_info << "AI Difficulty: " << difficulty;
-                if(difficulty == "Easy"){
-                    Config::Difficulty::AI_DECISION_INTERVAL_SEC = 10.f;
-                    Config::Difficulty::AI_MAX_EXECUTIONS_PER_TURN = 2;
-                    Config::Difficulty::AI_MAX_DISTANCE_TO_ATTACK = 300.f;
-                }else if(difficulty == "Medium"){
-                    Config::Difficulty::AI_DECISION_INTERVAL_SEC = 5.f;
-                    Config::Difficulty::AI_MAX_EXECUTIONS_PER_TURN = 10;
-                    Config::Difficulty::AI_MAX_DISTANCE_TO_ATTACK = 500.f;
-                }else if(difficulty == "Hard"){
-                    Config::Difficulty::AI_DECISION_INTERVAL_SEC = 3.f;
-                    Config::Difficulty::AI_MAX_EXECUTIONS_PER_TURN = 15;
-                    Config::Difficulty::AI_MAX_DISTANCE_TO_ATTACK = 750.f;
-                }else if(difficulty == "Impossible"){
-                    Config::Difficulty::AI_DECISION_INTERVAL_SEC = 1.f;
-                    Config::Difficulty::AI_MAX_EXECUTIONS_PER_TURN = 30;
-                    Config::Difficulty::AI_MAX_DISTANCE_TO_ATTACK = 2000.f;
-                }
+
+                Game::InputCommand command;
+                command.type = Game::InputCommand::Type::SetDifficulty;
+                command.difficulty = difficulty;
+                input.push(std::move(command));
             });
 
             // Add ComboBox to the panel
@@ -112,7 +102,7 @@ namespace Systems {
         }
 
         // Top Panel display logic
-        auto* gameState = manager.getGameStateComponent();
+        const auto* gameState = snapshot.hasGameState ? &snapshot.gameState : nullptr;
         if (gameState)
         {
             auto totalPlayers = gameState->playerDrones.size();
@@ -125,102 +115,88 @@ namespace Systems {
             {
                 std::stringstream ss;
                 ss << "Player 1";
-                ss << "\nDrones: " << gameState->playerDrones[Components::Faction::PLAYER_1];
-                auto playerDrones = gameState->playerDrones[Components::Faction::PLAYER_1];
-                auto playerEnergy = gameState->playerEnergy[Components::Faction::PLAYER_1];
+                ss << "\nDrones: " << gameState->playerDrones.at(Components::Faction::PLAYER_1);
+                auto playerDrones = gameState->playerDrones.at(Components::Faction::PLAYER_1);
+                auto playerEnergy = gameState->playerEnergy.at(Components::Faction::PLAYER_1);
 
                 if(playerEnergy <= playerDrones){
                     ss << " [production blocked]";
                 }
 
-                ss << "\nEnergy: " << gameState->playerEnergy[Components::Faction::PLAYER_1];
+                ss << "\nEnergy: " << gameState->playerEnergy.at(Components::Faction::PLAYER_1);
                 player1Label->setText(ss.str());
             }
 
             if(totalPlayers > 1){
                 std::stringstream ss;
                 ss << "Player 2";
-                auto playerDrones = gameState->playerDrones[Components::Faction::PLAYER_2];
-                auto playerEnergy = gameState->playerEnergy[Components::Faction::PLAYER_2];
+                auto playerDrones = gameState->playerDrones.at(Components::Faction::PLAYER_2);
+                auto playerEnergy = gameState->playerEnergy.at(Components::Faction::PLAYER_2);
 
                 ss << "\n";
                 if(playerEnergy <= playerDrones){
                     ss << " [production blocked] ";
                 }
-                ss << "Drones: " << gameState->playerDrones[Components::Faction::PLAYER_2];
+                ss << "Drones: " << gameState->playerDrones.at(Components::Faction::PLAYER_2);
 
 
-                ss << "\nEnergy: " << gameState->playerEnergy[Components::Faction::PLAYER_2];
+                ss << "\nEnergy: " << gameState->playerEnergy.at(Components::Faction::PLAYER_2);
                 player2Label->setText(ss.str());
             }
         }
         
         // Hover Panel display logic
-        bool entityHovered = false;
-        for (auto&& [id, hover] : manager.view<Components::HoverComponent>().each()) {
-
-            if (hover.isHovered) {
-                entityHovered = true;
-                infoPanel->setVisible(true);
-                infoPanel->setRenderer(theme->getRenderer("Panel"));
-                infoPanel->removeAllWidgets();
-
-                auto* factoryComp = manager.getComponent<Components::FactoryComponent>(id);
-                auto* powerPlantComp = manager.getComponent<Components::PowerPlantComponent>(id);
-                auto* garissonComp = manager.getComponent<Components::GarissonComponent>(id);
-                auto* shieldComp = manager.getComponent<Components::ShieldComponent>(id);
-
-                std::stringstream ss;
-
-                if (factoryComp) {
-                    ss << factoryComp->factoryName;
-
-                    float productionRate = factoryComp->droneProductionRate;
-
-                    // Format Production Rate and Time Left
-                    char buffer[100];
-                    std::snprintf(
-                        buffer, 
-                        sizeof(buffer), 
-                        "\nProduction rate: %.1f /s", 
-                        productionRate
-                    );
-                    ss << buffer;
-                }
-
-                if (powerPlantComp) {
-                    ss << "FusionReactor\nCapacity: " << powerPlantComp->capacity;
-                }
-
-                if(garissonComp){
-                    ss << "\nDrones stationed: " << garissonComp->getDroneCount();
-                }
+        const auto& hover = snapshot.hover;
+        if (hover.active) {
+            infoPanel->setVisible(true);
+            infoPanel->setRenderer(theme->getRenderer("Panel"));
+            infoPanel->removeAllWidgets();
+
+            std::stringstream ss;
+
+            if (hover.isFactory) {
+                ss << hover.factoryName;
+
+                // Format Production Rate and Time Left
+                char buffer[100];
+                std::snprintf(
+                    buffer, 
+                    sizeof(buffer), 
+                    "\nProduction rate: %.1f /s", 
+                    hover.productionRate
+                );
+                ss << buffer;
+            }
 
-                if(shieldComp){
-                    // Format Shield values
-                    char buffer[100];
-                    std::snprintf(
-                        buffer, 
-                        sizeof(buffer), 
-                        "\nShield: %.1f/%.1f\nShield Regen: %.1f/s", 
-                        shieldComp->currentShield, 
-                        shieldComp->maxShield, 
-                        shieldComp->regenRate
-                    );
-                    ss << buffer;
-                }
+            if (hover.isPowerPlant) {
+                ss << "FusionReactor\nCapacity: " << hover.capacity;
+            }
 
-                auto label = tgui::Label::create(ss.str());
-                label->setRenderer(theme->getRenderer("Label"));
-                label->setTextSize(Config::GUI_TEXT_SIZE);
-                infoPanel->add(label);
+            if(hover.hasGarrison){
+                ss << "\nDrones stationed: " << hover.drones;
+            }
 
-                infoPanel->setPosition({hover.position.x, hover.position.y});
-                break; // Show info for the first hovered entity only
+            if(hover.hasShield){
+                // Format Shield values
+                char buffer[100];
+                std::snprintf(
+                    buffer, 
+                    sizeof(buffer), 
+                    "\nShield: %.1f/%.1f\nShield Regen: %.1f/s", 
+                    hover.shield, 
+                    hover.maxShield, 
+                    hover.regenRate
+                );
+                ss << buffer;
             }
-        }
 
-        if (!entityHovered) {
+            auto label = tgui::Label::create(ss.str());
+            label->setRenderer(theme->getRenderer("Label"));
+            label->setTextSize(Config::GUI_TEXT_SIZE);
+            infoPanel->add(label);
+
+            infoPanel->setPosition({hover.screenPosition.x, hover.screenPosition.y});
+        } else {
             infoPanel->setVisible(false);
         }
 
@@ -277,7 +253,7 @@ namespace Systems {
             gui.add(fpsLabel);
         }
 
-        for(auto&& [id, debug] : manager.view<Components::DebugOverlayComponent>().each()) {
+        if (Config::ENABLE_DEBUG_SYMBOLS) {
             fpsLabel->setText("FPS: " + std::to_string(debug.fps));
             fpsLabel->setVisible(true);
         }
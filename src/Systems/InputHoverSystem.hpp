@@ -14,21 +14,27 @@
 #include "Game/GameEntityManager.hpp"
 
 namespace Systems {
-    void InputHoverSystem(Game::GameEntityManager& manager, const sf::RenderWindow& window) {
-        sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-        sf::Vector2f worldPos = window.mapPixelToCoords(mousePos);
-
-        for (auto&& [id, transform, shape, hover]: manager.view<Components::TransformComponent, Components::ShapeComponent, Components::HoverComponent>().each()) {
-            // Check if mouse is within entity bounds
-            if (shape.shape->getGlobalBounds().contains(worldPos)) {
-                hover.isHovered = true;
-                // hoverComp->position = worldPos;
-                hover.position = static_cast<sf::Vector2f>(mousePos);
-
-            } else {
-                hover.isHovered = false;
+    // Runs on the simulation thread with the mouse position forwarded by the window thread
+    void InputHoverSystem(Game::GameEntityManager& manager, sf::Vector2f worldPos, sf::Vector2f screenPos) {
+        // Only the entity under the mouse and the previously hovered one are touched
+        EntityID hoveredID = manager.pickEntity(worldPos);
+        if (hoveredID != NullEntityID && !manager.hasComponent<Components::HoverComponent>(hoveredID)) {
+            hoveredID = NullEntityID;
+        }
+
+        EntityID previousID = manager.getHoveredEntity();
+        if (previousID != hoveredID && previousID != NullEntityID) {
+            if (auto* previousHover = manager.getComponent<Components::HoverComponent>(previousID)) {
+                previousHover->isHovered = false;
             }
         }
+
+        if (hoveredID != NullEntityID) {
+            auto* hover = manager.getComponent<Components::HoverComponent>(hoveredID);
+            hover->isHovered = true;
+            hover->position = screenPos;
+        }
+        manager.setHoveredEntity(hoveredID);
     }
 }
 
@@ -4,6 +4,7 @@
 #include <unordered_map>
 #include <SFML/Graphics.hpp>
 #include <utility>
+#include <vector>
 
 
 #include "Config.hpp"
@@ -12,128 +13,117 @@
 #include "Components/AttackOrderComponent.hpp"
 #include "Components/DroneTransferComponent.hpp"
 #include "Components/FactionComponent.hpp"
+#include "Components/TransformComponent.hpp"
+#include "Components/ShapeComponent.hpp"
+#include "Components/GarissonComponent.hpp"
 
-#include "Game/Builder.hpp"
+#include "Game/GameEntityManager.hpp"
+#include "Game/InputCommand.hpp"
 
 #include "Utils/Logger.hpp"
 
 namespace Systems {
 
-    EntityID getPreviouslySelectedEntity(Game::GameEntityManager& manager){
-
-        auto entities = manager.getAllEntityIDs();
-        for (auto id : entities) {
-            auto* selectableComp = manager.getComponent<Components::SelectableComponent>(id);
-            if (selectableComp && selectableComp->isSelected) {
-                return id;
-            }
-        }
-        return NullEntityID;
-    }
-
-    EntityID getSelectedEntity(const sf::Event& event, Game::GameEntityManager& manager, const sf::RenderWindow& window){
-        sf::Vector2f worldPos = window.mapPixelToCoords(sf::Vector2i(event.mouseButton.x, event.mouseButton.y));
-
-        auto entities = manager.getAllEntityIDs();
-        // Determine if a new selection was made
-        for (auto targetID : entities) {
-            auto* targetTransform = manager.getComponent<Components::TransformComponent>(targetID);
-            auto* targetShapeComp = manager.getComponent<Components::ShapeComponent>(targetID);
-            auto* targetSelectableComp = manager.getComponent<Components::SelectableComponent>(targetID);
-
-            if (targetTransform && targetShapeComp && targetSelectableComp) {
-                    // Check if mouse is within entity bounds (eg. click on entity)
-                if (targetShapeComp->shape->getGlobalBounds().contains(worldPos)){
-                    return targetID;
+    void handleLeftClick(Game::GameEntityManager& manager, EntityID selectedEntityID) {
+        bool hasSelection = !manager.getSelection().empty();
+
+        if(hasSelection && selectedEntityID == NullEntityID){
+            // Targets already have been selected previously
+            // No new target is selected now
+            // Cancel old selection
+            manager.clearSelection();
+
+        }else if (hasSelection && !manager.isSelected(selectedEntityID)) {
+            // Targets have already been selected previously
+            // This new selection is different than the old ones
+            // Add attack orders from every selected player garrison
+            for (auto sourceID : manager.getSelection()) {
+                auto* factionComp = manager.getComponent<Components::FactionComponent>(sourceID);
+                if(factionComp && factionComp->faction == Components::Faction::PLAYER_1){
+                    manager.getCommandBuffer().emplace<Components::AttackOrderComponent>(sourceID, sourceID, selectedEntityID);
                 }
             }
+            // deselect targets after attack order
+            manager.clearSelection();
+
+        }else if(!hasSelection && selectedEntityID != NullEntityID){
+            // A target has not been selected previously
+            // This is the first selection
+            // Select the target
+            auto* factionComp = manager.getComponent<Components::FactionComponent>(selectedEntityID);
+            if(factionComp && factionComp->faction == Components::Faction::PLAYER_1){
+                manager.select(selectedEntityID);
+            }
+        }else{
+            // do nothing
         }
-        return NullEntityID;
     }
 
-    void InputSelectionSystem(const sf::Event& event, Game::GameEntityManager& manager, const sf::RenderWindow& window) {
+    void handleRightClick(Game::GameEntityManager& manager, EntityID selectedEntityID) {
+        bool hasSelection = !manager.getSelection().empty();
 
-        if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
-            // Get the click position in world coordinates
-            
-            EntityID previouslySelectedEntityID = getPreviouslySelectedEntity(manager);
-            EntityID selectedEntityID = getSelectedEntity(event, manager, window);
+        if(hasSelection && selectedEntityID == NullEntityID){
+            // Targets already have been selected previously
+            // No new target is selected now
+            // Cancel old selection and orders
+            for (auto sourceID : manager.getSelection()) {
+                manager.getCommandBuffer().remove<Components::DroneTransferComponent>(sourceID);
+            }
+            manager.clearSelection();
 
-            if(previouslySelectedEntityID != NullEntityID && selectedEntityID == NullEntityID){
-                // A target already has been selected previously
-                // No new target is selected now
-                // Cancel old selection
-                manager.getComponent<Components::SelectableComponent>(previouslySelectedEntityID)->isSelected = false;
+        }else if(hasSelection && !manager.isSelected(selectedEntityID)){
+            // Targets have already been selected previously
+            // This new selection is different than the old ones
+            // Add transfer orders
+            auto* targetGarissonComp = manager.getComponent<Components::GarissonComponent>(selectedEntityID);
 
-            }else if (previouslySelectedEntityID != NullEntityID && previouslySelectedEntityID != selectedEntityID) {
-                // A target has already been selected previously
-                // This new selection is different than the old one
-                // Add attack orders
+            for (auto sourceID : manager.getSelection()) {
+                auto* sourceGarissonComp = manager.getComponent<Components::GarissonComponent>(sourceID);
+                auto* factionComp = manager.getComponent<Components::FactionComponent>(sourceID);
 
-                // log_info << "Attack entity " << selectedEntityID << " from " << previouslySelectedEntityID;              
-                auto* factionComp = manager.getComponent<Components::FactionComponent>(previouslySelectedEntityID);
-                if(factionComp->faction == Components::Faction::PLAYER_1){
-                    manager.addOrReplaceComponent<Components::AttackOrderComponent>(previouslySelectedEntityID, previouslySelectedEntityID, selectedEntityID);
-                }               
-                // deselect targets after attack order
-                manager.getComponent<Components::SelectableComponent>(previouslySelectedEntityID)->isSelected = false;
-                manager.getComponent<Components::SelectableComponent>(selectedEntityID)->isSelected = false;
-
-            }else if(previouslySelectedEntityID == NullEntityID && selectedEntityID != NullEntityID){
-                // A target has not been selected previously
-                // This is the first selection
-                // Select the target
-                auto* factionComp = manager.getComponent<Components::FactionComponent>(selectedEntityID);
-                if(factionComp->faction == Components::Faction::PLAYER_1){
-                    manager.getComponent<Components::SelectableComponent>(selectedEntityID)->isSelected = true;
+                if(sourceGarissonComp && targetGarissonComp && factionComp && factionComp->faction == Components::Faction::PLAYER_1){
+                    manager.getCommandBuffer().emplace<Components::DroneTransferComponent>(sourceID, sourceID, selectedEntityID, factionComp->faction);
                 }
-            }else{
-                // do nothing
             }
-        }
 
-        if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Right) {
-            EntityID previouslySelectedEntityID = getPreviouslySelectedEntity(manager);
-            EntityID selectedEntityID = getSelectedEntity(event, manager, window);
-
-            if(previouslySelectedEntityID != NullEntityID && selectedEntityID == NullEntityID){
-                // A target already has been selected previously
-                // No new target is selected now
-                // Cancel old selection and orders
-                auto* transferComp = manager.getComponent<Components::DroneTransferComponent>(previouslySelectedEntityID);
-                if(transferComp){
-                    manager.removeComponent<Components::DroneTransferComponent>(previouslySelectedEntityID);
-                }
-                // deselect
-                manager.getComponent<Components::SelectableComponent>(previouslySelectedEntityID)->isSelected = false;
+            // deselect all targets
+            manager.clearSelection();
+        }
+    }
 
-            }else if(previouslySelectedEntityID != NullEntityID && previouslySelectedEntityID != selectedEntityID){
-                // A target has already been selected previously
-                // This new selection is different than the old one
-                // Add transfer orders
+    // Replace the selection with every player garrison inside the box
+    void selectInBox(Game::GameEntityManager& manager, const sf::FloatRect& box) {
+        auto& picked = manager.getPickScratch();
+        picked.clear();
+        manager.pickEntities(box, picked);
+
+        manager.clearSelection();
+        for (auto id : picked) {
+            auto* factionComp = manager.getComponent<Components::FactionComponent>(id);
+            if (factionComp && factionComp->faction == Components::Faction::PLAYER_1) {
+                manager.select(id);
+            }
+        }
+    }
 
-                auto* sourceGarissonComp = manager.getComponent<Components::GarissonComponent>(previouslySelectedEntityID);
-                auto* targetGarissonComp = manager.getComponent<Components::GarissonComponent>(selectedEntityID);
-                // auto* sourceTransferComp = entityManager.getComponent<Components::DroneTransferComponent>(previouslySelectedEntityID);
+    // Applies a click or box selection forwarded by the window thread, on the simulation thread
+    void InputSelectionSystem(Game::GameEntityManager& manager, const Game::InputCommand& command) {
 
-                if(sourceGarissonComp && targetGarissonComp){
-                    auto* factionComp = manager.getComponent<Components::FactionComponent>(previouslySelectedEntityID);
+        if (command.type == Game::InputCommand::Type::LeftClick) {
+            handleLeftClick(manager, manager.pickEntity(command.position));
+        }
 
-                    if(factionComp->faction == Components::Faction::PLAYER_1){
-                        // log_info << "adding transfer component...";
-                        manager.addOrReplaceComponent<Components::DroneTransferComponent>(previouslySelectedEntityID, previouslySelectedEntityID, selectedEntityID, factionComp->faction);
-                    }
-                }
+        if (command.type == Game::InputCommand::Type::BoxSelect) {
+            selectInBox(manager, command.box);
+        }
 
-                // deselect both targets
-                manager.getComponent<Components::SelectableComponent>(previouslySelectedEntityID)->isSelected = false;
-                manager.getComponent<Components::SelectableComponent>(selectedEntityID)->isSelected = false;
-            }
+        if (command.type == Game::InputCommand::Type::RightClick) {
+            handleRightClick(manager, manager.pickEntity(command.position));
         }
 
         /* -- Debug --
         if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Middle){
-            auto selectedEntityID = getSelectedEntity(event, manager, window);
+            auto selectedEntityID = manager.pickEntity(command.position);
             if(selectedEntityID != NullEntityID){
                 auto* factionComp = manager.getComponent<Components::FactionComponent>(selectedEntityID);
 
@@ -1,56 +1,55 @@
 #ifndef TEXT_UPDATE_SYSTEM_HPP
 #define TEXT_UPDATE_SYSTEM_HPP
 
-#include <unordered_map>
-#include <sstream>
+#include <cstdio>
+#include <string>
 
-
-#include "Components/TransformComponent.hpp"
 #include "Components/LabelComponent.hpp"
-#include "Components/ShieldComponent.hpp"
+#include "Components/FactoryComponent.hpp"
+#include "Components/PowerPlantComponent.hpp"
 #include "Components/GarissonComponent.hpp"
 
 #include "Game/GameEntityManager.hpp"
+#include "Utils/JobSystem.hpp"
 
 namespace Systems {
+    // Labels per job; formatting one costs a few microseconds
+    constexpr std::size_t LABEL_GRAIN = 64;
+
+    // Formats the label strings. Fonts and text layout belong to the window thread,
+    // which picks up changed strings through the render snapshot.
     void LabelUpdateSystem(Game::GameEntityManager& manager, float dt) {
+        auto view = manager.view<Components::LabelComponent>();
 
-        for (auto&& [id, transform, labelComp] : manager.view<Components::TransformComponent, Components::LabelComponent>().each()) {
+        Utils::JobSystem::get().parallelForEach(view, LABEL_GRAIN, [&](EntityID id) {
+            auto& labelComp = view.get<Components::LabelComponent>(id);
 
-            // Update the text position based on parent position + offset
-            labelComp.text.setPosition(transform.getPosition() + labelComp.offset);
-            labelComp.text2.setPosition(transform.getPosition());
+            // Nothing the text depends on changed since it was last formatted
+            if (!labelComp.dirty) {
+                return;
+            }
+            labelComp.dirty = false;
 
             // Update the text on the label:
             auto* factory = manager.getComponent<Components::FactoryComponent>(id);
             auto* powerPlant = manager.getComponent<Components::PowerPlantComponent>(id);
-            auto* drone = manager.getComponent<Components::DroneComponent>(id);
             auto* garisson = manager.getComponent<Components::GarissonComponent>(id);
 
-            std::stringstream ss;
+            char buffer[50];
+            buffer[0] = '\0';
             if(factory){
-                char buffer[50];
                 // std::snprintf(buffer, sizeof(buffer), "Factory %d\n%.1f/s",id, factory->droneProductionRate);
                 std::snprintf(buffer, sizeof(buffer), "Factory\n%.1f/s",factory->droneProductionRate);
-                ss << buffer;
             }
             if(powerPlant){
-                char buffer[50];
                 // std::snprintf(buffer, sizeof(buffer), "FusionReactor %d\nCapacity: %d", id, powerPlant->capacity);
                 std::snprintf(buffer, sizeof(buffer), "FusionReactor\nCapacity: %d", powerPlant->capacity);
-                ss << buffer;
-            }
-            if(drone){
-                ss << drone->droneName;
             }
+            labelComp.text = buffer;
+
             if(garisson){
                 if (garisson->getDroneCount() > 0){
-                    labelComp.text2.setString(std::to_string(garisson->getDroneCount()));
-                    sf::FloatRect textBounds = labelComp.text2.getLocalBounds();
-                    labelComp.text2.setOrigin(
-                        textBounds.left + textBounds.width / 2.f, 
-                        textBounds.top + textBounds.height / 2.f
-                    );
+                    labelComp.count = std::to_string(garisson->getDroneCount());
                 }
             }
 
@@ -58,10 +57,9 @@ namespace Systems {
             // if(shield){
             //     ss << "\nShield: " << shield->getShield() << "/" << shield->maxShield;
             // }
-            labelComp.text.setString(ss.str());
-            
-        }
+            labelComp.version++;
+        });
     }
 }
 
-#endif // TEXT_UPDATE_SYSTEM_HPP
\ No newline at end of file
+#endif // TEXT_UPDATE_SYSTEM_HPP
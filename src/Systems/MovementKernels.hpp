@@ -0,0 +1,159 @@
+#ifndef MOVEMENT_KERNELS_HPP
+#define MOVEMENT_KERNELS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MOVEMENT_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+// Straight-line move towards a target, over structure-of-arrays buffers.
+// Every kernel matches the scalar one: stop within max(5, 10% of speed) or when the
+// step would overshoot, otherwise advance by speed * dt along the direction.
+namespace Systems::MovementKernels {
+
+    using Kernel = void (*)(float* x, float* y, const float* targetX, const float* targetY,
+                            const float* speed, float dt, std::uint8_t* arrived, std::size_t count);
+
+    void moveScalar(float* x, float* y, const float* targetX, const float* targetY,
+                    const float* speed, float dt, std::uint8_t* arrived, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            float dx = targetX[i] - x[i];
+            float dy = targetY[i] - y[i];
+            float distance = std::sqrt(dx * dx + dy * dy);
+            float stoppingDistance = std::max(5.0f, speed[i] * 0.1f);
+            float step = speed[i] * dt;
+
+            if (distance <= stoppingDistance || step >= distance) {
+                x[i] = targetX[i];
+                y[i] = targetY[i];
+                arrived[i] = 1;
+            } else {
+                float scale = step / distance;
+                x[i] += dx * scale;
+                y[i] += dy * scale;
+                arrived[i] = 0;
+            }
+        }
+    }
+
+    void moveScalarAll(float* x, float* y, const float* targetX, const float* targetY,
+                       const float* speed, float dt, std::uint8_t* arrived, std::size_t count) {
+        moveScalar(x, y, targetX, targetY, speed, dt, arrived, 0, count);
+    }
+
+#ifdef MOVEMENT_KERNELS_X86
+    // SSE2 is part of x86-64, no dispatch needed
+    void moveSSE(float* x, float* y, const float* targetX, const float* targetY,
+                 const float* speed, float dt, std::uint8_t* arrived, std::size_t count) {
+        const __m128 dtv = _mm_set1_ps(dt);
+        const __m128 minStop = _mm_set1_ps(5.f);
+        const __m128 stopFactor = _mm_set1_ps(0.1f);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128 px = _mm_loadu_ps(x + i);
+            __m128 py = _mm_loadu_ps(y + i);
+            __m128 tx = _mm_loadu_ps(targetX + i);
+            __m128 ty = _mm_loadu_ps(targetY + i);
+            __m128 sp = _mm_loadu_ps(speed + i);
+
+            __m128 dx = _mm_sub_ps(tx, px);
+            __m128 dy = _mm_sub_ps(ty, py);
+            __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+            __m128 stoppingDistance = _mm_max_ps(minStop, _mm_mul_ps(sp, stopFactor));
+            __m128 step = _mm_mul_ps(sp, dtv);
+
+            __m128 done = _mm_or_ps(_mm_cmple_ps(distance, stoppingDistance), _mm_cmpge_ps(step, distance));
+            // Lanes that are done may divide by zero, their result is discarded below
+            __m128 scale = _mm_div_ps(step, distance);
+            __m128 nx = _mm_add_ps(px, _mm_mul_ps(dx, scale));
+            __m128 ny = _mm_add_ps(py, _mm_mul_ps(dy, scale));
+
+            _mm_storeu_ps(x + i, _mm_or_ps(_mm_and_ps(done, tx), _mm_andnot_ps(done, nx)));
+            _mm_storeu_ps(y + i, _mm_or_ps(_mm_and_ps(done, ty), _mm_andnot_ps(done, ny)));
+
+            int mask = _mm_movemask_ps(done);
+            for (int lane = 0; lane < 4; ++lane) {
+                arrived[i + lane] = (mask >> lane) & 1;
+            }
+        }
+        moveScalar(x, y, targetX, targetY, speed, dt, arrived, i, count);
+    }
+
+#if defined(__GNUC__) || defined(__clang__)
+#define MOVEMENT_KERNELS_AVX2 1
+    __attribute__((target("avx2")))
+    void moveAVX2(float* x, float* y, const float* targetX, const float* targetY,
+                  const float* speed, float dt, std::uint8_t* arrived, std::size_t count) {
+        const __m256 dtv = _mm256_set1_ps(dt);
+        const __m256 minStop = _mm256_set1_ps(5.f);
+        const __m256 stopFactor = _mm256_set1_ps(0.1f);
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256 px = _mm256_loadu_ps(x + i);
+            __m256 py = _mm256_loadu_ps(y + i);
+            __m256 tx = _mm256_loadu_ps(targetX + i);
+            __m256 ty = _mm256_loadu_ps(targetY + i);
+            __m256 sp = _mm256_loadu_ps(speed + i);
+
+            __m256 dx = _mm256_sub_ps(tx, px);
+            __m256 dy = _mm256_sub_ps(ty, py);
+            __m256 distance = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+            __m256 stoppingDistance = _mm256_max_ps(minStop, _mm256_mul_ps(sp, stopFactor));
+            __m256 step = _mm256_mul_ps(sp, dtv);
+
+            __m256 done = _mm256_or_ps(_mm256_cmp_ps(distance, stoppingDistance, _CMP_LE_OQ), _mm256_cmp_ps(step, distance, _CMP_GE_OQ));
+            __m256 scale = _mm256_div_ps(step, distance);
+            __m256 nx = _mm256_add_ps(px, _mm256_mul_ps(dx, scale));
+            __m256 ny = _mm256_add_ps(py, _mm256_mul_ps(dy, scale));
+
+            _mm256_storeu_ps(x + i, _mm256_blendv_ps(nx, tx, done));
+            _mm256_storeu_ps(y + i, _mm256_blendv_ps(ny, ty, done));
+
+            int mask = _mm256_movemask_ps(done);
+            for (int lane = 0; lane < 8; ++lane) {
+                arrived[i + lane] = (mask >> lane) & 1;
+            }
+        }
+        moveScalar(x, y, targetX, targetY, speed, dt, arrived, i, count);
+    }
+#endif
+#endif
+
+    // Best kernel for this CPU, picked once
+    Kernel selectKernel() {
+#ifdef MOVEMENT_KERNELS_AVX2
+        if (__builtin_cpu_supports("avx2")) {
+            return &moveAVX2;
+        }
+#endif
+#ifdef MOVEMENT_KERNELS_X86
+        return &moveSSE;
+#else
+        return &moveScalarAll;
+#endif
+    }
+
+    const char* getKernelName(Kernel kernel) {
+#ifdef MOVEMENT_KERNELS_AVX2
+        if (kernel == &moveAVX2) return "avx2";
+#endif
+#ifdef MOVEMENT_KERNELS_X86
+        if (kernel == &moveSSE) return "sse";
+#endif
+        return "scalar";
+    }
+
+    Kernel getKernel() {
+        static const Kernel kernel = selectKernel();
+        return kernel;
+    }
+}
+
+#endif // MOVEMENT_KERNELS_HPP
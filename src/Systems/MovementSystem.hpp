@@ -1,54 +1,66 @@
 #ifndef MOVEMENT_SYSTEM_HPP
 #define MOVEMENT_SYSTEM_HPP
 
-#include <unordered_map>
-#include <cmath>
+#include <algorithm>
+#include <cstdint>
 
 #include "Components/TransformComponent.hpp"
 #include "Components/MoveComponent.hpp"
+#include "Systems/MovementKernels.hpp"
 #include "Config.hpp"
 #include "Utils/Logger.hpp"
+#include "Utils/JobSystem.hpp"
 
 namespace Systems {
+    // Below this many movers a tick stays on the calling thread
+    constexpr std::size_t MOVEMENT_GRAIN = 4096;
+
+    // Movers stay in the SoA buffers between ticks, rows come and go with MoveComponent writes.
+    // A TransformComponent is written once its entity arrives; until then the render snapshot
+    // reads the position from the buffers.
     void MovementSystem(Game::GameEntityManager& manager, float dt) {
+        auto& grid = manager.getSpatialGrid();
+        auto& buffers = manager.getMovementBuffers();
+
+        // Angular rotation, for the few entities that spin
+        for (auto id : buffers.spinning) {
+            auto* transform = manager.getComponent<Components::TransformComponent>(id);
+            auto* move = manager.getComponent<Components::MoveComponent>(id);
+            transform->transform.setRotation(transform->getRotation() + move->angularVelocity * dt);
+        }
+
+        const std::size_t count = buffers.size();
+        auto kernel = MovementKernels::getKernel();
 
-        for (auto&& [id, transform, move] : manager.view<Components::TransformComponent, Components::MoveComponent>().each()) {
-
-                // Handle movement towards target
-            if (move.moveToTarget) {
-                sf::Vector2f direction = move.targetPosition - transform.getPosition();
-                float distance = std::sqrt(direction.x * direction.x + direction.y * direction.y);
-
-                float stoppingDistance = std::max(5.0f, move.speed * 0.1f); // 10% of speed, min 5 pixels
-                if (distance > stoppingDistance) { // Stop if close enough
-
-                    direction /= distance; // Normalize direction vector
-
-                    // Move towards the target
-                    float step = move.speed * dt;
-
-                    // Prevent overshooting by clamping step
-                    if (step >= distance) {
-                        transform.transform.setPosition(move.targetPosition);
-                        move.moveToTarget = false; // Stop movement
-                    } else {
-                        sf::Vector2f newPosition = transform.getPosition() + direction * step;
-                        transform.transform.setPosition(newPosition);
-
-                        // Rotate towards target
-                        float angle = std::atan2(direction.y, direction.x) * Config::RAD_TO_DEG;
-                        transform.transform.setRotation(angle + 90.f); // Align triangle tip
-                    }
-                } else {
-                    // Snap to target when very close
-                    transform.transform.setPosition(move.targetPosition);
-                    move.moveToTarget = false; // Stop movement
-                }
+        // Rows are independent: each chunk moves its own slice and flags the rows that changed cell
+        Utils::JobSystem::get().parallelFor(count, MOVEMENT_GRAIN, [&](std::size_t begin, std::size_t end) {
+            // Keep last tick's position for render interpolation
+            std::copy(buffers.x.begin() + begin, buffers.x.begin() + end, buffers.previousX.begin() + begin);
+            std::copy(buffers.y.begin() + begin, buffers.y.begin() + end, buffers.previousY.begin() + begin);
+
+            kernel(buffers.x.data() + begin, buffers.y.data() + begin, buffers.targetX.data() + begin, buffers.targetY.data() + begin,
+                buffers.speed.data() + begin, dt, buffers.arrived.data() + begin, end - begin);
+
+            for (std::size_t i = begin; i < end; ++i) {
+                std::int64_t cell = grid.cellOf(sf::Vector2f(buffers.x[i], buffers.y[i]));
+                buffers.cellChanged[i] = cell != buffers.cells[i];
+                buffers.cells[i] = cell;
             }
+        });
 
-            // Handle angular rotation
-            float newRotation = transform.getRotation() + move.angularVelocity * dt;
-            transform.transform.setRotation(newRotation);
+        // The grid and the components are shared, update them on this thread. Backwards, so a
+        // swap-remove only brings in rows already visited.
+        for (std::size_t i = count; i-- > 0;) {
+            if (buffers.cellChanged[i]) {
+                grid.update(buffers.ids[i], sf::Vector2f(buffers.x[i], buffers.y[i]));
+            }
+            if (buffers.arrived[i]) {
+                EntityID id = buffers.ids[i];
+                // Settles where it stopped, no interpolation past the last step
+                manager.getComponent<Components::TransformComponent>(id)->teleport(sf::Vector2f(buffers.x[i], buffers.y[i]));
+                manager.getComponent<Components::MoveComponent>(id)->moveToTarget = false; // Stop movement
+                buffers.removeRow(static_cast<std::uint32_t>(i));
+            }
         }
     }
 }
@@ -56,4 +68,4 @@ namespace Systems {
 
 
 
-#endif // MOVEMENT_SYSTEM_HPP
\ No newline at end of file
+#endif // MOVEMENT_SYSTEM_HPP
@@ -46,7 +46,7 @@ namespace Systems {
                 }
                 
                 // Add one drone to player
-                garisson.incrementDroneCount();
+                manager.patchComponent<Components::GarissonComponent>(id, [](auto& garisson){ garisson.incrementDroneCount(); });
                 gameState->playerDrones[faction.faction]++;
             }
         }
@@ -0,0 +1,55 @@
+#ifndef PROFILER_OVERLAY_SYSTEM_HPP
+#define PROFILER_OVERLAY_SYSTEM_HPP
+
+#include <cstdio>
+#include <string>
+#include <TGUI/TGUI.hpp>
+#include <TGUI/Backend/SFML-Graphics.hpp>
+
+#include "Components/ProfilerOverlayComponent.hpp"
+#include "Resources/ResourceManager.hpp"
+#include "Utils/Profiler.hpp"
+#include "Config.hpp"
+
+namespace Systems {
+
+    // Rolling min/avg/p99 per profiled section (toggle: F3, dump CSV: F4)
+    void ProfilerOverlaySystem(const Utils::Profiler& profiler, Components::ProfilerOverlayComponent& overlay, tgui::Gui& gui, bool visible) {
+        if (!overlay.panel) {
+            auto theme = Resource::ResourceManager::getInstance().getTheme(Resource::Paths::DARK_THEME);
+            overlay.panel = tgui::Panel::create({"420", "100% - 140"});
+            overlay.panel->setRenderer(theme->getRenderer("Panel"));
+            overlay.panel->setPosition({"10", "110"}); // Below the top panel
+            overlay.panel->setVisible(false);
+
+            overlay.label = tgui::Label::create();
+            overlay.label->setRenderer(theme->getRenderer("Label"));
+            overlay.label->setTextSize(Config::GUI_TEXT_SIZE - 4);
+            overlay.panel->add(overlay.label);
+
+            gui.add(overlay.panel);
+        }
+
+        overlay.panel->setVisible(visible);
+        if (!visible) {
+            return;
+        }
+
+        std::string text = "ms            min     avg     p99\n";
+        std::size_t sectionCount = Utils::Profiler::getSectionCount();
+        for (std::size_t id = 0; id < sectionCount; ++id) {
+            auto stats = profiler.getStats(id);
+            if (stats.samples == 0) {
+                continue;
+            }
+
+            char buffer[128];
+            std::snprintf(buffer, sizeof(buffer), "%-14.14s %6.3f  %6.3f  %6.3f\n",
+                Utils::Profiler::getSectionName(id).c_str(), stats.minMs, stats.avgMs, stats.p99Ms);
+            text += buffer;
+        }
+        overlay.label->setText(text);
+    }
+}
+
+#endif // PROFILER_OVERLAY_SYSTEM_HPP
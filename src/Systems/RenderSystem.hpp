@@ -1,153 +1,271 @@
 #ifndef RENDER_SYSTEM_HPP
 #define RENDER_SYSTEM_HPP
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <unordered_map>
 #include <SFML/Graphics.hpp>
 
-#include "Components/TransformComponent.hpp"
-#include "Components/SpriteComponent.hpp"
-#include "Components/ShapeComponent.hpp"
-#include "Components/LabelComponent.hpp"
-#include "Components/SelectableComponent.hpp"
 #include "Components/FactionComponent.hpp"
-#include "Components/ShieldComponent.hpp"
-#include "Components/GarissonComponent.hpp"
-#include "Components/DroneTransferComponent.hpp"
+#include "Components/ShapeComponent.hpp"
+
+#include "Game/RenderCache.hpp"
+#include "Game/RenderSnapshot.hpp"
 
+#include "Resources/ResourceManager.hpp"
 #include "Utils/Graphics.hpp"
+#include "Utils/Profiler.hpp"
 
 namespace Systems {
 
-    void RenderSystem(Game::GameEntityManager& manager, sf::RenderWindow& window) {
-        auto entities = manager.getAllEntityIDs();
-        
+    sf::Color getFactionColor(Components::Faction faction) {
+        if (faction == Components::Faction::PLAYER_1) {
+            return sf::Color::Red;
+        }else if(faction == Components::Faction::PLAYER_2) {
+            return sf::Color::Blue;
+        }else if(faction == Components::Faction::PLAYER_3) {
+            return sf::Color::Green;
+        }else if(faction == Components::Faction::PLAYER_4) {
+            return sf::Color::Yellow;
+        }else if(faction == Components::Faction::PLAYER_5) {
+            return sf::Color::Magenta;
+        }else if(faction == Components::Faction::PLAYER_6) {
+            return sf::Color::Cyan;
+        }else if(faction == Components::Faction::PLAYER_7) {
+            return sf::Color(255, 140, 0);
+        }else if(faction == Components::Faction::PLAYER_8) {
+            return sf::Color(150, 60, 200);
+        }
+        return sf::Color(100, 100, 100);
+    }
+
+    // Draws a snapshot published by the simulation thread; never touches the registry.
+    // The snapshot is already culled to the camera (see SnapshotSystem), everything in it is drawn.
+    // alpha: interpolation factor between the tick before the snapshot and the snapshot
+    void RenderSystem(const Game::RenderSnapshot& snapshot, sf::RenderTarget& window, float alpha, Game::RenderCache& cache) {
+        cache.frame++;
 
         // Layer 0
         // Background
 
         // Draw transfer lines
-        for(auto&& [entityID, transform, transfer] : 
-                    manager.view<
-                        Components::TransformComponent, 
-                        Components::DroneTransferComponent
-                    >().each()) {
-            
-            auto* targetTransform = manager.getComponent<Components::TransformComponent>(transfer.target);
-            if(targetTransform){
-                sf::Color transparentWhite(255, 255, 255, 128); // 50% Transparent White 
-                Utils::drawGradientDottedLine(window, transform.getPosition(), targetTransform->getPosition(), 10.f);
+        {
+            PROFILE_SCOPE("Render::Transfers");
+            bool changed = false;
+            for (const auto& item : snapshot.routes) {
+                auto& route = cache.routes[{item.source, item.target}];
+                if (route.frame == 0 || route.start != item.start || route.end != item.end) {
+                    route.start = item.start;
+                    route.end = item.end;
+                    changed = true;
+                }
+                route.frame = cache.frame;
+            }
+
+            // Drop routes that were cancelled or completed
+            if (snapshot.routes.size() != cache.routes.size()) {
+                for (auto it = cache.routes.begin(); it != cache.routes.end();) {
+                    it = it->second.frame != cache.frame ? cache.routes.erase(it) : std::next(it);
+                }
+                changed = true;
             }
+
+            if (changed) {
+                cache.routeVertices.clear();
+                for (const auto& [key, route] : cache.routes) {
+                    Utils::appendGradientDottedLine(cache.routeVertices, route.start, route.end, 10.f);
+                }
+            }
+            window.draw(cache.routeVertices);
         }
 
         // Draw Selection
-        for(auto&& [id, transform, selectable] : manager.view<
-                    Components::TransformComponent,
-                    Components::SelectableComponent>().each()) {
-                        
-            if(selectable.isSelected){
+        for (const auto& structure : snapshot.structures) {
+            if (structure.selected) {
                 sf::CircleShape selectionShape(Config::FACTORY_SIZE);
                 selectionShape.setOrigin(Config::FACTORY_SIZE, Config::FACTORY_SIZE);
                 selectionShape.setFillColor(sf::Color(255,255,0,200));
-                selectionShape.setPosition(transform.getPosition());
+                selectionShape.setPosition(structure.position);
                 window.draw(selectionShape);
             }
         }
 
         // Draw Sprites
-        for(auto&& [id, transform, sprite] : manager.view<
-                    Components::TransformComponent, 
-                    Components::SpriteComponent
-                >().each()) {
-            
-            sprite.sprite.setPosition(transform.getPosition());
-            sprite.sprite.setRotation(transform.getRotation());
-            sprite.sprite.setScale(transform.getScale());
-            window.draw(sprite.sprite);
+        for (const auto& sprite : snapshot.sprites) {
+            window.draw(sprite);
         }
 
         // Draw Shields
-        for(auto&& [id, transform, shield] : manager.view<
-                    Components::TransformComponent, 
-                    Components::ShieldComponent
-                >().each()) {
-            
-            sf::Vector2f center(transform.getPosition().x, transform.getPosition().y);
-            float baseRadius = 50.f;       // Base radius for the first circle
-            float radiusStep = 7.f;       // Space between concentric circles
-            float thickness = 7.f;         // Circle thickness
-            int pointCount = 50;           // Smoothness of the arc
-
-            // Calculate full circles and remainder (using float logic for smooth rendering)
-            float shieldValue = shield.currentShield;
-            int fullCircles = static_cast<int>(shieldValue / 10.f); // Number of full circles
-            float remainder = std::fmod(shieldValue, 10.f);         // Remaining fractional shield value
-
-            // Draw Full Circles
-            for (int i = 0; i < fullCircles; ++i) {
-                float currentRadius = baseRadius + (i * radiusStep);
-
-                sf::VertexArray arc = Utils::CreateArc(
-                    center,
-                    currentRadius,
-                    thickness,
-                    1.0f, // 100% full circle
-                    pointCount,
-                    sf::Color(0, 255, 255, 200)
-                );
-
-                window.draw(arc);
+        {
+            PROFILE_SCOPE("Render::Shields");
+            const float baseRadius = 50.f;      // Base radius for the first circle
+            const float radiusStep = 7.f;       // Space between concentric circles
+            const float thickness = 7.f;        // Circle thickness
+            const float shieldPerRing = 10.f;
+            const float quantum = shieldPerRing / Utils::RING_SEGMENTS; // Shield covered by one arc segment
+
+            using ShieldEntry = Game::RenderCache::ShieldEntry;
+            const std::size_t slotVertices = Game::RenderCache::SHIELD_SLOT_VERTICES;
+            static_assert(Game::RenderCache::SHIELD_SLOT_VERTICES == Game::RenderCache::MAX_SHIELD_RINGS * Utils::RING_SEGMENTS * 6,
+                "A shield slot holds every segment of its rings");
+
+            // Rewrites one shield's slot, and clears what its previous rings covered beyond the new ones
+            auto writeSlot = [&](ShieldEntry& entry, int segments) {
+                sf::Vertex* out = &cache.shieldVertices[entry.slot * slotVertices];
+                std::size_t written = 0;
+                // Full circles first, then the partial circle for the remainder
+                for (int ring = 0, remaining = segments; remaining > 0 && ring < Game::RenderCache::MAX_SHIELD_RINGS; ++ring, remaining -= Utils::RING_SEGMENTS) {
+                    written += Utils::writeRingArc(out + written, entry.center, baseRadius + ring * radiusStep, thickness,
+                        std::min(remaining, Utils::RING_SEGMENTS), sf::Color(0, 255, 255, 200));
+                }
+                if (written < entry.vertexCount) {
+                    std::fill(out + written, out + entry.vertexCount, sf::Vertex());
+                }
+                entry.vertexCount = written;
+            };
+
+            std::size_t seen = 0;
+            for (const auto& structure : snapshot.structures) {
+                if (!structure.hasShield) {
+                    continue;
+                }
+
+                int segments = structure.shield > 0.f ? static_cast<int>(std::ceil(structure.shield / quantum)) : 0;
+                auto [it, inserted] = cache.shields.try_emplace(structure.id);
+                auto& entry = it->second;
+                if (inserted) {
+                    if (!cache.freeShieldSlots.empty()) {
+                        entry.slot = cache.freeShieldSlots.back();
+                        cache.freeShieldSlots.pop_back();
+                    } else {
+                        entry.slot = cache.shieldVertices.getVertexCount() / slotVertices;
+                        cache.shieldVertices.resize(cache.shieldVertices.getVertexCount() + slotVertices);
+                    }
+                }
+                if (entry.segments != segments || entry.center != structure.position) {
+                    entry.segments = segments;
+                    entry.center = structure.position;
+                    writeSlot(entry, segments);
+                }
+                entry.frame = cache.frame;
+                seen++;
             }
 
-            // Draw Partial Circle for Remainder
-            if (remainder > 0.f) {
-                float currentRadius = baseRadius + (fullCircles * radiusStep);
-                float percentage = remainder / 10.0f; // Partial fill percentage (0.0 to 1.0)
-
-                sf::VertexArray arc = Utils::CreateArc(
-                    center,
-                    currentRadius,
-                    thickness,
-                    percentage,
-                    pointCount,
-                    sf::Color(0, 255, 255, 200) // Yellow for the partial arc
-                );
-                window.draw(arc);
+            // Free the slots of removed or no longer visible entities
+            if (seen != cache.shields.size()) {
+                for (auto it = cache.shields.begin(); it != cache.shields.end();) {
+                    if (it->second.frame == cache.frame) {
+                        ++it;
+                        continue;
+                    }
+                    writeSlot(it->second, 0);
+                    cache.freeShieldSlots.push_back(it->second.slot);
+                    it = cache.shields.erase(it);
+                }
             }
+            window.draw(cache.shieldVertices);
         }
 
-        // Draw Shapes
-        for(auto&& [id, transform, shape] : manager.view<
-                    Components::TransformComponent, 
-                    Components::ShapeComponent
-                >().each()) {
-            
-            shape.shape->setPosition(transform.getPosition());
-            shape.shape->setRotation(transform.getRotation());
-            shape.shape->setScale(transform.getScale());
-
-            auto* faction = manager.getComponent<Components::FactionComponent>(id);
-            if (faction) {
-                if (faction->faction == Components::Faction::PLAYER_1) {
-                    shape.shape->setFillColor(sf::Color::Red);
-                }else if(faction->faction == Components::Faction::PLAYER_2) {
-                    shape.shape->setFillColor(sf::Color::Blue);
-                }else{
-                    // shape->shape->setFillColor(sf::Color::White);
+        // Draw Shapes and Fleets: one vertex array, built from shared archetype geometry
+        {
+            auto& shapeVertices = cache.shapeVertices;
+            shapeVertices.clear();
+
+            {
+                PROFILE_SCOPE("Render::Shapes");
+                for (const auto& structure : snapshot.structures) {
+                    Utils::appendShape(shapeVertices, structure.shape, structure.position,
+                        structure.size, structure.rotation, getFactionColor(structure.faction));
+                }
+            }
+
+            // Drones are expanded to triangles only here
+            {
+                PROFILE_SCOPE("Render::Fleets");
+                const auto& triangle = Utils::getUnitGeometry(Components::ShapeType::Triangle);
+                const float length = Config::DRONE_LENGTH;
+                // Fleet positions only exist here, computed from the flight
+                double renderTime = snapshot.simulationTime - snapshot.stepSeconds * (1.0 - alpha);
+                for (const auto& item : snapshot.fleets) {
+                    const auto& fleet = item.fleet;
+                    const auto& flight = item.flight;
+                    sf::Vector2f center = flight.getPosition(renderTime);
+                    float shrink = 1.f - flight.getProgress(renderTime);
+
+                    // Rotate the shared triangle once per fleet
+                    float radians = flight.rotation * 3.14159265f / 180.f;
+                    float c = std::cos(radians) * length;
+                    float s = std::sin(radians) * length;
+                    sf::Vector2f points[3];
+                    for (int k = 0; k < 3; ++k) {
+                        points[k] = sf::Vector2f(triangle[k].x * c - triangle[k].y * s, triangle[k].x * s + triangle[k].y * c);
+                    }
+                    sf::Color color = getFactionColor(item.faction);
+
+                    for (unsigned int i = 0; i < fleet.droneCount; ++i) {
+                        sf::Vector2f position = center + fleet.getDroneOffset(i) * shrink;
+                        shapeVertices.append(sf::Vertex(position + points[0], color));
+                        shapeVertices.append(sf::Vertex(position + points[1], color));
+                        shapeVertices.append(sf::Vertex(position + points[2], color));
+                    }
+                }
+
+                for (const auto& drone : snapshot.drones) {
+                    sf::Vector2f position = drone.previousPosition + (drone.position - drone.previousPosition) * alpha;
+                    Utils::appendShape(shapeVertices, Components::ShapeType::Triangle, position,
+                        length, drone.rotation, getFactionColor(drone.faction));
                 }
             }
-            window.draw(*shape.shape);
+
+            window.draw(shapeVertices);
         }
 
         // Draw labels (non-gui)
-        for (auto&& [id, label] : manager.view<Components::LabelComponent>().each()) {
-            window.draw(label.text);
-            window.draw(label.text2);
+        {
+            PROFILE_SCOPE("Render::Labels");
+            for (const auto& label : snapshot.labels) {
+                auto& entry = cache.labels[label.id];
+                if (!entry.initialized) {
+                    const sf::Font& font = Resource::ResourceManager::getInstance().getFont(Resource::Paths::FONT_TOXIGENESIS);
+                    for (sf::Text* text : {&entry.text, &entry.count}) {
+                        text->setFont(font);
+                        text->setCharacterSize(label.fontSize);
+                        text->setFillColor(label.color);
+                    }
+                    entry.initialized = true;
+                }
+                if (entry.version != label.version) {
+                    entry.version = label.version;
+                    entry.text.setString(label.text);
+                    entry.count.setString(label.count);
+
+                    // The count is centered on the parent
+                    sf::FloatRect textBounds = entry.count.getLocalBounds();
+                    entry.count.setOrigin(
+                        textBounds.left + textBounds.width / 2.f, 
+                        textBounds.top + textBounds.height / 2.f
+                    );
+                }
+                entry.text.setPosition(label.position + label.offset);
+                entry.count.setPosition(label.position);
+                entry.frame = cache.frame;
+
+                window.draw(entry.text);
+                window.draw(entry.count);
+            }
+
+            // Some entity lost its label: keep only the texts drawn this frame
+            if (cache.labels.size() > snapshot.labels.size()) {
+                for (auto it = cache.labels.begin(); it != cache.labels.end();) {
+                    it = it->second.frame != cache.frame ? cache.labels.erase(it) : std::next(it);
+                }
+            }
         }
 
         // Draw Debug Symbols
-        auto* aiComp = manager.getAIComponent();
-        if (aiComp && Config::ENABLE_DEBUG_SYMBOLS) { 
-            for (auto& target : aiComp->debug.pinkDebugTargets) {
+        if (Config::ENABLE_DEBUG_SYMBOLS) { 
+            for (auto& target : snapshot.pinkDebugTargets) {
                 sf::CircleShape selectionShape(20.f);
                 selectionShape.setOrigin(10.f, 10.f);
                 selectionShape.setFillColor(sf::Color::Magenta);
@@ -155,7 +273,7 @@ namespace Systems {
                 window.draw(selectionShape);
             }
 
-            for (auto& target : aiComp->debug.yellowDebugTargets) {
+            for (auto& target : snapshot.yellowDebugTargets) {
                 sf::CircleShape selectionShape(20.f);
                 selectionShape.setOrigin(10.f, 10.f);
                 selectionShape.setFillColor(sf::Color::Yellow);
@@ -6,14 +6,21 @@
 
 #include "Game/GameEntityManager.hpp"
 #include "Components/ShieldComponent.hpp"
+#include "Utils/JobSystem.hpp"
 
 namespace Systems {
+    // Shields per job, regeneration is only a few flops each
+    constexpr std::size_t SHIELD_GRAIN = 2048;
+
     void ShieldSystem(Game::GameEntityManager& manager, float dt) {
+        auto view = manager.view<Components::ShieldComponent>();
+
+        Utils::JobSystem::get().parallelForEach(view, SHIELD_GRAIN, [&](EntityID id) {
+            auto& shield = view.get<Components::ShieldComponent>(id);
 
-        for (auto&& [id, shield] : manager.view<Components::ShieldComponent>().each()) {
             // Skip if shield is already full
             if(shield.maxShield == shield.currentShield){
-                continue;
+                return;
             }
 
             // Regenerate shield smoothly based on regenRate and delta time (dt)
@@ -23,7 +30,7 @@ namespace Systems {
             if (shield.currentShield > shield.maxShield) {
                 shield.currentShield = shield.maxShield;
             }
-        }
+        });
     }
 }
 
@@ -0,0 +1,218 @@
+#ifndef SNAPSHOT_SYSTEM_HPP
+#define SNAPSHOT_SYSTEM_HPP
+
+#include <algorithm>
+#include <vector>
+
+#include "Components/TransformComponent.hpp"
+#include "Components/SpriteComponent.hpp"
+#include "Components/ShapeComponent.hpp"
+#include "Components/LabelComponent.hpp"
+#include "Components/SelectableComponent.hpp"
+#include "Components/HoverComponent.hpp"
+#include "Components/FactionComponent.hpp"
+#include "Components/FactoryComponent.hpp"
+#include "Components/PowerPlantComponent.hpp"
+#include "Components/ShieldComponent.hpp"
+#include "Components/GarissonComponent.hpp"
+#include "Components/DroneTransferComponent.hpp"
+#include "Components/FleetComponent.hpp"
+#include "Components/FlightComponent.hpp"
+#include "Components/DroneComponent.hpp"
+#include "Components/GameStateComponent.hpp"
+#include "Components/AIComponent.hpp"
+
+#include "Game/GameEntityManager.hpp"
+#include "Game/RenderSnapshot.hpp"
+
+#include "Config.hpp"
+
+namespace Systems {
+
+    // Next element of a snapshot vector being refilled. Elements are overwritten
+    // rather than cleared, so strings and vectors keep their capacity.
+    template<typename T>
+    T& nextSnapshotItem(std::vector<T>& items, std::size_t& count) {
+        if (count == items.size()) {
+            items.emplace_back();
+        }
+        return items[count++];
+    }
+
+    // Copies what the window thread draws into snapshot. Runs on the simulation thread
+    // between ticks; snapshot is the back slot of the triple buffer.
+    // view: world rect of the camera, margin included (see RenderSnapshot::getCullRect). Only the
+    // grid cells it overlaps are copied; without one (headless, benchmarks) everything is.
+    void SnapshotSystem(Game::GameEntityManager& manager, Game::RenderSnapshot& snapshot, unsigned long tick, float stepSeconds, const sf::FloatRect* view = nullptr) {
+        snapshot.tick = tick;
+        snapshot.simulationTime = manager.getSimulationTime();
+        snapshot.stepSeconds = stepSeconds;
+
+        auto& visible = manager.getViewScratch();
+        visible.clear();
+        if (view) {
+            manager.getSpatialGrid().query(*view, visible);
+        } else {
+            for (auto id : manager.view<Components::TransformComponent>()) {
+                visible.push_back(id);
+            }
+        }
+
+        // Structures, sprites, loose drones and labels of the visible entities
+        std::size_t structureCount = 0;
+        std::size_t spriteCount = 0;
+        std::size_t droneCount = 0;
+        std::size_t labelCount = 0;
+        const auto& movers = manager.getMovementBuffers();
+        for (auto id : visible) {
+            const auto& transform = *manager.getComponent<Components::TransformComponent>(id);
+            auto* faction = manager.getComponent<Components::FactionComponent>(id);
+
+            auto* shape = manager.getComponent<Components::ShapeComponent>(id);
+            if (shape && faction) {
+                auto& structure = nextSnapshotItem(snapshot.structures, structureCount);
+                structure.id = id;
+                structure.position = transform.getPosition();
+                structure.shape = shape->type;
+                structure.size = shape->size * transform.getScale().x;
+                structure.rotation = transform.getRotation();
+                structure.faction = faction->faction;
+
+                auto* selectable = manager.getComponent<Components::SelectableComponent>(id);
+                structure.selected = selectable && selectable->isSelected;
+
+                auto* shield = manager.getComponent<Components::ShieldComponent>(id);
+                structure.hasShield = shield != nullptr;
+                structure.shield = shield ? shield->currentShield : 0.f;
+            }
+
+            // Sprites, already placed
+            if (auto* sprite = manager.getComponent<Components::SpriteComponent>(id)) {
+                auto& item = nextSnapshotItem(snapshot.sprites, spriteCount);
+                item = sprite->sprite;
+                item.setPosition(transform.getPosition());
+                item.setRotation(transform.getRotation());
+                item.setScale(transform.getScale());
+            }
+
+            // Loose drones, those on the move are positioned by the movement buffers
+            if (faction && manager.getComponent<Components::DroneComponent>(id)) {
+                auto& item = nextSnapshotItem(snapshot.drones, droneCount);
+                auto row = movers.rowOf(id);
+                if (row != Game::MovementBuffers::NO_ROW) {
+                    item.previousPosition = sf::Vector2f(movers.previousX[row], movers.previousY[row]);
+                    item.position = sf::Vector2f(movers.x[row], movers.y[row]);
+                } else {
+                    item.previousPosition = transform.previousPosition;
+                    item.position = transform.getPosition();
+                }
+                item.rotation = transform.getRotation();
+                item.faction = faction->faction;
+            }
+
+            // Labels: strings are copied only when they changed since this slot last held them
+            if (auto* label = manager.getComponent<Components::LabelComponent>(id)) {
+                auto& item = nextSnapshotItem(snapshot.labels, labelCount);
+                if (item.id != id || item.version != label->version) {
+                    item.id = id;
+                    item.version = label->version;
+                    item.text = label->text;
+                    item.count = label->count;
+                }
+                item.position = transform.getPosition();
+                item.offset = label->offset;
+                item.fontSize = label->fontSize;
+                item.color = label->color;
+            }
+        }
+        snapshot.structures.resize(structureCount);
+        snapshot.sprites.resize(spriteCount);
+        snapshot.drones.resize(droneCount);
+        snapshot.labels.resize(labelCount);
+
+        // Fleets in flight, positioned by the window thread from their flight. Kept when
+        // any part of their path is in view, they may fly into it before the next snapshot.
+        std::size_t count = 0;
+        for (auto&& [id, fleet, flight, faction] : manager.view<Components::FleetComponent, Components::FlightComponent, Components::FactionComponent>().each()) {
+            if (view) {
+                sf::Vector2f low(std::min(flight.launchPosition.x, flight.targetPosition.x), std::min(flight.launchPosition.y, flight.targetPosition.y));
+                sf::Vector2f high(std::max(flight.launchPosition.x, flight.targetPosition.x), std::max(flight.launchPosition.y, flight.targetPosition.y));
+                if (!view->intersects(sf::FloatRect(low, high - low))) {
+                    continue;
+                }
+            }
+            auto& item = nextSnapshotItem(snapshot.fleets, count);
+            item.fleet = fleet;
+            item.flight = flight;
+            item.faction = faction.faction;
+        }
+        snapshot.fleets.resize(count);
+
+        // Transfer routes, all of them: both ends can be off screen with the line crossing the
+        // view, and the window thread rebuilds their geometry only when they change
+        count = 0;
+        for (auto&& [id, transform, transfer] : manager.view<Components::TransformComponent, Components::DroneTransferComponent>().each()) {
+            auto* targetTransform = manager.getComponent<Components::TransformComponent>(transfer.target);
+            if (!targetTransform) {
+                continue;
+            }
+            auto& route = nextSnapshotItem(snapshot.routes, count);
+            route.source = transfer.source;
+            route.target = transfer.target;
+            route.start = transform.getPosition();
+            route.end = targetTransform->getPosition();
+        }
+        snapshot.routes.resize(count);
+
+        // Hovered structure
+        auto& hover = snapshot.hover;
+        EntityID hoveredID = manager.getHoveredEntity();
+        auto* hoverComp = hoveredID != NullEntityID ? manager.getComponent<Components::HoverComponent>(hoveredID) : nullptr;
+        hover.active = hoverComp && hoverComp->isHovered;
+        if (hover.active) {
+            hover.screenPosition = hoverComp->position;
+
+            auto* factory = manager.getComponent<Components::FactoryComponent>(hoveredID);
+            hover.isFactory = factory != nullptr;
+            if (factory) {
+                hover.factoryName = factory->factoryName;
+                hover.productionRate = factory->droneProductionRate;
+            }
+
+            auto* powerPlant = manager.getComponent<Components::PowerPlantComponent>(hoveredID);
+            hover.isPowerPlant = powerPlant != nullptr;
+            hover.capacity = powerPlant ? powerPlant->capacity : 0;
+
+            auto* garisson = manager.getComponent<Components::GarissonComponent>(hoveredID);
+            hover.hasGarrison = garisson != nullptr;
+            hover.drones = garisson ? garisson->getDroneCount() : 0;
+
+            auto* shield = manager.getComponent<Components::ShieldComponent>(hoveredID);
+            hover.hasShield = shield != nullptr;
+            if (shield) {
+                hover.shield = shield->currentShield;
+                hover.maxShield = shield->maxShield;
+                hover.regenRate = shield->regenRate;
+            }
+        }
+
+        auto* gameState = manager.getGameStateComponent();
+        snapshot.hasGameState = gameState != nullptr;
+        if (gameState) {
+            snapshot.gameState = *gameState;
+        }
+
+        snapshot.pinkDebugTargets.clear();
+        snapshot.yellowDebugTargets.clear();
+        for (std::size_t f = 1; f < Components::FACTION_COUNT && Config::ENABLE_DEBUG_SYMBOLS; ++f) {
+            auto* aiComp = manager.getAIComponent(static_cast<Components::Faction>(f));
+            if (aiComp) {
+                const auto& debug = aiComp->debug;
+                snapshot.pinkDebugTargets.insert(snapshot.pinkDebugTargets.end(), debug.pinkDebugTargets.begin(), debug.pinkDebugTargets.end());
+                snapshot.yellowDebugTargets.insert(snapshot.yellowDebugTargets.end(), debug.yellowDebugTargets.begin(), debug.yellowDebugTargets.end());
+            }
+        }
+    }
+}
+
+#endif // SNAPSHOT_SYSTEM_HPP
@@ -3,90 +3,110 @@
 
 #include <SFML/Graphics.hpp>
 #include <cmath>
+#include <vector>
 
-namespace Utils {
-    sf::VertexArray CreateArc(sf::Vector2f center, float radius, float thickness, float percentage, int pointCount, sf::Color color = sf::Color::Cyan) {
-        sf::VertexArray arc(sf::TrianglesStrip);
-        float startAngle = -90.0f; // Start from top
-        float sweepAngle = 360.0f * percentage; // Calculate angle range
-
-        for (int i = 0; i <= pointCount; ++i) {
-            float angle = startAngle + (sweepAngle * i / pointCount);
-            float rad = angle * (3.14159265359f / 180.0f); // Convert to radians
-
-            // Outer point
-            sf::Vector2f outerPoint = center + sf::Vector2f(
-                std::cos(rad) * radius,
-                std::sin(rad) * radius
-            );
-
-            // Inner point (thickness applied)
-            sf::Vector2f innerPoint = center + sf::Vector2f(
-                std::cos(rad) * (radius - thickness),
-                std::sin(rad) * (radius - thickness)
-            );
+#include "Components/ShapeComponent.hpp"
 
-            arc.append(sf::Vertex(outerPoint, color));
-            arc.append(sf::Vertex(innerPoint, color));
+namespace Utils {
+    // Triangle list of a unit sized shape (half extent 1), built once per archetype
+    const std::vector<sf::Vector2f>& getUnitGeometry(Components::ShapeType type) {
+        static const std::vector<sf::Vector2f> square = {
+            {-1.f, -1.f}, {1.f, -1.f}, {1.f, 1.f},
+            {-1.f, -1.f}, {1.f, 1.f}, {-1.f, 1.f}
+        };
+        static const std::vector<sf::Vector2f> triangle = {
+            {0.f, -1.f}, {-1.f, 1.f}, {1.f, 1.f}
+        };
+        static const std::vector<sf::Vector2f> circle = [](){
+            const int pointCount = 30; // Same as sf::CircleShape
+            std::vector<sf::Vector2f> vertices;
+            vertices.reserve(pointCount * 3);
+            for (int i = 0; i < pointCount; ++i) {
+                float a0 = 2.f * 3.14159265359f * i / pointCount;
+                float a1 = 2.f * 3.14159265359f * (i + 1) / pointCount;
+                vertices.push_back({0.f, 0.f});
+                vertices.push_back({std::cos(a0), std::sin(a0)});
+                vertices.push_back({std::cos(a1), std::sin(a1)});
+            }
+            return vertices;
+        }();
+
+        switch (type) {
+            case Components::ShapeType::Circle: return circle;
+            case Components::ShapeType::Triangle: return triangle;
+            default: return square;
         }
-
-        return arc;
     }
 
-    // Function to draw a dotted line
-    void drawDottedCircles(sf::RenderWindow& window, sf::Vector2f start, sf::Vector2f end, float dotSpacing, float dotRadius) {
-        sf::Vector2f direction = end - start;
-        float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
-
-        // Normalize direction vector
-        direction /= length;
-
-        // Place dots along the line
-        for (float i = 0; i < length; i += dotSpacing) {
-            sf::Vector2f position = start + direction * i;
-            sf::CircleShape dot(dotRadius);
-            dot.setFillColor(sf::Color::White);
-            dot.setPosition(position - sf::Vector2f(dotRadius, dotRadius)); // Center the dot
+    // Append one shape to a sf::Triangles vertex array, rotation in degrees
+    void appendShape(sf::VertexArray& vertices, Components::ShapeType type, sf::Vector2f center, float size, float rotation, sf::Color color) {
+        const auto& geometry = getUnitGeometry(type);
+        if (rotation == 0.f) {
+            for (const auto& point : geometry) {
+                vertices.append(sf::Vertex(center + point * size, color));
+            }
+            return;
+        }
 
-            window.draw(dot);
+        float radians = rotation * 3.14159265359f / 180.f;
+        float c = std::cos(radians) * size;
+        float s = std::sin(radians) * size;
+        for (const auto& point : geometry) {
+            vertices.append(sf::Vertex(center + sf::Vector2f(point.x * c - point.y * s, point.x * s + point.y * c), color));
         }
     }
 
-    void drawDottedLine(sf::RenderWindow& window, sf::Vector2f start, sf::Vector2f end, float dotSpacing, sf::Color color) {
-        sf::Vector2f direction = end - start;
-        float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
-
-        direction /= length;
-
-        sf::VertexArray dots(sf::Points);
+    // Points on a unit circle, clockwise from the top, RING_SEGMENTS + 1 entries (first == last)
+    const int RING_SEGMENTS = 50;
+    const std::vector<sf::Vector2f>& getUnitRing() {
+        static const std::vector<sf::Vector2f> ring = [](){
+            std::vector<sf::Vector2f> points;
+            points.reserve(RING_SEGMENTS + 1);
+            for (int i = 0; i <= RING_SEGMENTS; ++i) {
+                float rad = (-90.f + 360.f * i / RING_SEGMENTS) * (3.14159265359f / 180.0f);
+                points.push_back({std::cos(rad), std::sin(rad)});
+            }
+            return points;
+        }();
+        return ring;
+    }
 
-        for (float i = 0; i < length; i += dotSpacing) {
-            sf::Vector2f position = start + direction * i;
-            dots.append(sf::Vertex(position, color));
+    // Write the first `segments` segments of a ring, clockwise from the top, as sf::Triangles
+    // from out onwards, 6 vertices per segment. Returns the number of vertices written.
+    std::size_t writeRingArc(sf::Vertex* out, sf::Vector2f center, float radius, float thickness, int segments, sf::Color color) {
+        const auto& ring = getUnitRing();
+        float innerRadius = radius - thickness;
+        std::size_t written = 0;
+        for (int i = 0; i < segments && i < RING_SEGMENTS; ++i) {
+            sf::Vector2f outer0 = center + ring[i] * radius;
+            sf::Vector2f inner0 = center + ring[i] * innerRadius;
+            sf::Vector2f outer1 = center + ring[i + 1] * radius;
+            sf::Vector2f inner1 = center + ring[i + 1] * innerRadius;
+
+            out[written++] = sf::Vertex(outer0, color);
+            out[written++] = sf::Vertex(inner0, color);
+            out[written++] = sf::Vertex(outer1, color);
+            out[written++] = sf::Vertex(inner0, color);
+            out[written++] = sf::Vertex(inner1, color);
+            out[written++] = sf::Vertex(outer1, color);
         }
-
-        window.draw(dots);
+        return written;
     }
 
-    void drawGradientDottedLine(sf::RenderWindow& window, sf::Vector2f start, sf::Vector2f end, float dotSpacing) {
+    // Dotted line fading in towards end, dots go into a sf::Triangles array
+    void appendGradientDottedLine(sf::VertexArray& vertices, sf::Vector2f start, sf::Vector2f end, float dotSpacing, float dotRadius = 3.f) {
         sf::Vector2f direction = end - start;
         float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+        if (length <= 0.f) {
+            return;
+        }
         direction /= length;
 
         for (float i = 0; i < length; i += dotSpacing) {
-            sf::Vector2f position = start + direction * i;
             sf::Color color = sf::Color(255, 255, 255,  255 * (i/ length)); // Gradient effect
-
-            sf::CircleShape dot(3.f);
-            dot.setFillColor(color);
-            dot.setPosition(position - sf::Vector2f(3.f, 3.f));
-
-            window.draw(dot);
+            appendShape(vertices, Components::ShapeType::Circle, start + direction * i, dotRadius, 0.f, color);
         }
     }
-
-
-
 }
 
 #endif // CIRCLE_HPP
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include "JobSystem.hpp"
+
+#include "Utils/Logger.hpp"
+
+namespace Utils {
+
+    namespace {
+        // Index of the pool worker running on this thread, none for outside threads
+        thread_local const JobSystem* currentPool = nullptr;
+        thread_local std::size_t currentWorker = 0;
+        thread_local const void* currentContext = nullptr;
+        thread_local JobSystem* threadPool = nullptr;
+
+        std::size_t getDefaultWorkerCount()
+        {
+            unsigned int threads = std::thread::hardware_concurrency();
+            std::size_t workerCount = threads > 1 ? threads - 1 : 0;
+            log_info << "Job system: " << workerCount << " worker threads";
+            return workerCount;
+        }
+    }
+
+    JobSystem::JobSystem(std::size_t workerCount)
+        : queues(std::make_unique<Queue[]>(workerCount + 1)), queueCount(workerCount + 1)
+    {
+        workers.reserve(workerCount);
+        for (std::size_t i = 0; i < workerCount; ++i) {
+            workers.emplace_back(&JobSystem::workerLoop, this, i);
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping.store(true);
+        }
+        wake.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    JobSystem& JobSystem::get()
+    {
+        if (threadPool) {
+            return *threadPool;
+        }
+        static JobSystem instance(getDefaultWorkerCount());
+        return instance;
+    }
+
+    void JobSystem::setThreadPool(JobSystem* pool)
+    {
+        threadPool = pool;
+    }
+
+    std::optional<std::size_t> JobSystem::getCurrentWorker()
+    {
+        if (!currentPool) {
+            return std::nullopt;
+        }
+        return currentWorker;
+    }
+
+    void JobSystem::workerLoop(std::size_t workerIndex)
+    {
+        currentPool = this;
+        currentWorker = workerIndex;
+
+        while (true) {
+            if (runOne(workerIndex)) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wake.wait(lock, [this](){ return stopping.load() || queuedJobs.load() > 0; });
+            if (stopping.load()) {
+                return;
+            }
+        }
+    }
+
+    const void* JobSystem::getContext()
+    {
+        return currentContext;
+    }
+
+    void JobSystem::setContext(const void* context)
+    {
+        currentContext = context;
+    }
+
+    void JobSystem::dispatch(void (*fn)(const void*, std::size_t, std::size_t), const void* data, std::size_t count, std::size_t chunkSize)
+    {
+        std::atomic<std::size_t> pending{0};
+        std::size_t queueIndex = getQueueIndex();
+
+        // The first chunk stays with this thread, the rest is up for grabs
+        for (std::size_t begin = chunkSize; begin < count; begin += chunkSize) {
+            Job job{fn, data, begin, std::min(begin + chunkSize, count), &pending, currentContext};
+            pending.fetch_add(1, std::memory_order_relaxed);
+            if (!push(queueIndex, job)) {
+                // Queue full: no point waiting for room
+                execute(job);
+            }
+        }
+        {
+            // Workers check queuedJobs under this lock, so none can miss the wake up
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        wake.notify_all();
+
+        fn(data, 0, std::min(chunkSize, count));
+
+        while (pending.load(std::memory_order_acquire) > 0) {
+            if (!runOne(queueIndex)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    bool JobSystem::push(std::size_t queueIndex, const Job& job)
+    {
+        Queue& queue = queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.size == QUEUE_CAPACITY) {
+            return false;
+        }
+        queue.jobs[(queue.front + queue.size) % QUEUE_CAPACITY] = job;
+        queue.size++;
+        queuedJobs.fetch_add(1);
+        return true;
+    }
+
+    bool JobSystem::popBack(std::size_t queueIndex, Job& job)
+    {
+        Queue& queue = queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.size == 0) {
+            return false;
+        }
+        queue.size--;
+        job = queue.jobs[(queue.front + queue.size) % QUEUE_CAPACITY];
+        queuedJobs.fetch_sub(1);
+        return true;
+    }
+
+    bool JobSystem::popFront(std::size_t queueIndex, Job& job)
+    {
+        Queue& queue = queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.size == 0) {
+            return false;
+        }
+        job = queue.jobs[queue.front];
+        queue.front = (queue.front + 1) % QUEUE_CAPACITY;
+        queue.size--;
+        queuedJobs.fetch_sub(1);
+        return true;
+    }
+
+    bool JobSystem::runOne(std::size_t queueIndex)
+    {
+        if (queuedJobs.load() == 0) {
+            return false;
+        }
+
+        Job job;
+        if (popBack(queueIndex, job)) {
+            execute(job);
+            return true;
+        }
+        for (std::size_t i = 1; i < queueCount; ++i) {
+            if (popFront((queueIndex + i) % queueCount, job)) {
+                execute(job);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::size_t JobSystem::getQueueIndex() const
+    {
+        return currentPool == this ? currentWorker : queueCount - 1;
+    }
+
+    void JobSystem::execute(const Job& job)
+    {
+        const void* previousContext = currentContext;
+        currentContext = job.context;
+        job.fn(job.data, job.begin, job.end);
+        currentContext = previousContext;
+        job.pending->fetch_sub(1, std::memory_order_release);
+    }
+}
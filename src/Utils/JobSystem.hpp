@@ -0,0 +1,144 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace Utils {
+
+    // Fixed pool of worker threads with one job queue each. Idle workers steal
+    // from the other queues, and the thread calling parallelFor runs jobs while
+    // it waits, so a call never depends on a worker being awake.
+    class JobSystem {
+    public:
+        // Runs [begin, end) of a parallelFor, counts `pending` down when done
+        struct Job {
+            void (*fn)(const void* data, std::size_t begin, std::size_t end) = nullptr;
+            const void* data = nullptr;
+            std::size_t begin = 0;
+            std::size_t end = 0;
+            std::atomic<std::size_t>* pending = nullptr;
+            const void* context = nullptr;  // Caller's context, installed while the job runs
+        };
+
+        explicit JobSystem(std::size_t workerCount);
+        ~JobSystem();
+
+        // Prevent Copying
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        // Pool parallelFor calls on this thread go to: the process-wide pool, one worker per
+        // hardware thread besides the caller, unless the thread has set one of its own
+        static JobSystem& get();
+        static void setThreadPool(JobSystem* pool);     // Null: back to the process-wide pool
+
+        std::size_t getWorkerCount() const { return workers.size(); }
+
+        // Index of the calling thread among the workers of its pool, none outside a pool
+        static std::optional<std::size_t> getCurrentWorker();
+
+        // Opaque per-thread pointer that follows parallelFor jobs to the threads running them
+        static const void* getContext();
+        static void setContext(const void* context);
+
+        // Calls fn(begin, end) on disjoint sub-ranges of [0, count) no shorter than `grain`
+        // and returns when all are done. Ranges up to `grain` run inline.
+        template<typename Fn>
+        void parallelFor(std::size_t count, std::size_t grain, const Fn& fn) {
+            grain = std::max<std::size_t>(grain, 1);
+            if (count == 0) {
+                return;
+            }
+            if (workers.empty() || count <= grain) {
+                fn(std::size_t(0), count);
+                return;
+            }
+
+            // A few chunks per thread, so stealing can even out uneven chunks
+            std::size_t chunks = std::min({(count + grain - 1) / grain, (workers.size() + 1) * 4, MAX_CHUNKS});
+            std::size_t chunkSize = (count + chunks - 1) / chunks;
+            dispatch([](const void* data, std::size_t begin, std::size_t end) {
+                (*static_cast<const Fn*>(data))(begin, end);
+            }, &fn, count, chunkSize);
+        }
+
+        // Calls fn(entity) for every entity of an entt view, split into chunks of view iterators
+        template<typename View, typename Fn>
+        void parallelForEach(const View& view, std::size_t grain, const Fn& fn) {
+            auto first = view.begin();
+            auto last = view.end();
+            std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+            grain = std::max<std::size_t>(grain, 1);
+            if (workers.empty() || count <= grain) {
+                for (; first != last; ++first) {
+                    fn(*first);
+                }
+                return;
+            }
+
+            std::size_t chunks = std::min({(count + grain - 1) / grain, (workers.size() + 1) * 4, MAX_CHUNKS});
+            std::size_t chunkSize = (count + chunks - 1) / chunks;
+            std::optional<decltype(first)> starts[MAX_CHUNKS];
+            chunks = 0;
+            for (std::size_t offset = 0; offset < count; offset += chunkSize) {
+                starts[chunks++] = first;
+                std::advance(first, std::min(chunkSize, count - offset));
+            }
+
+            parallelFor(chunks, 1, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t chunk = begin; chunk < end; ++chunk) {
+                    auto it = *starts[chunk];
+                    std::size_t length = std::min(chunkSize, count - chunk * chunkSize);
+                    for (std::size_t i = 0; i < length; ++i, ++it) {
+                        fn(*it);
+                    }
+                }
+            });
+        }
+
+    private:
+        static constexpr std::size_t QUEUE_CAPACITY = 1024;
+        static constexpr std::size_t MAX_CHUNKS = 256;
+
+        // Owner pushes and pops at the back, thieves take from the front
+        struct Queue {
+            std::mutex mutex;
+            Job jobs[QUEUE_CAPACITY];
+            std::size_t front = 0;
+            std::size_t size = 0;
+        };
+
+        std::vector<std::thread> workers;
+        // One per worker plus a shared one (the last) for threads outside the pool
+        std::unique_ptr<Queue[]> queues;
+        std::size_t queueCount = 0;
+
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+        std::atomic<std::size_t> queuedJobs{0};
+        std::atomic<bool> stopping{false};
+
+        void workerLoop(std::size_t workerIndex);
+        void dispatch(void (*fn)(const void*, std::size_t, std::size_t), const void* data, std::size_t count, std::size_t chunkSize);
+
+        bool push(std::size_t queueIndex, const Job& job);
+        bool popBack(std::size_t queueIndex, Job& job);
+        bool popFront(std::size_t queueIndex, Job& job);
+
+        // Runs one job from our own queue, or one stolen from another; false if all are empty
+        bool runOne(std::size_t queueIndex);
+        std::size_t getQueueIndex() const;
+        static void execute(const Job& job);
+    };
+}
+
+#endif // JOB_SYSTEM_HPP
@@ -0,0 +1,141 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include "Utils/Logger.hpp"
+
+namespace Utils {
+
+    namespace {
+        std::mutex sectionMutex;
+        std::vector<std::string> sectionNames;
+
+        thread_local Profiler* currentProfiler = nullptr;
+    }
+
+    Profiler::Profiler() : rings(std::make_unique<Ring[]>(MAX_SECTIONS))
+    {
+    }
+
+    void Profiler::record(std::size_t sectionId, float ms)
+    {
+        if (sectionId >= MAX_SECTIONS) {
+            return;
+        }
+
+        Ring& ring = rings[sectionId];
+        std::uint32_t slot = ring.writeIndex.fetch_add(1, std::memory_order_acq_rel) % RING_SIZE;
+        ring.ms[slot].store(ms, std::memory_order_relaxed);
+        ring.frames[slot].store(frame.load(std::memory_order_relaxed), std::memory_order_release);
+    }
+
+    std::size_t Profiler::snapshot(std::size_t sectionId, float* ms, std::uint32_t* frames) const
+    {
+        if (sectionId >= MAX_SECTIONS) {
+            return 0;
+        }
+
+        const Ring& ring = rings[sectionId];
+        std::uint32_t written = ring.writeIndex.load(std::memory_order_acquire);
+        std::size_t count = std::min<std::size_t>(written, RING_SIZE);
+        std::uint32_t first = written - static_cast<std::uint32_t>(count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            std::size_t slot = (first + i) % RING_SIZE;
+            ms[i] = ring.ms[slot].load(std::memory_order_relaxed);
+            if (frames) {
+                frames[i] = ring.frames[slot].load(std::memory_order_acquire);
+            }
+        }
+        return count;
+    }
+
+    Profiler::Stats Profiler::getStats(std::size_t sectionId) const
+    {
+        std::array<float, RING_SIZE> samples;
+        Stats stats;
+        stats.samples = snapshot(sectionId, samples.data(), nullptr);
+        if (stats.samples == 0) {
+            return stats;
+        }
+
+        float sum = 0.f;
+        stats.minMs = samples[0];
+        for (std::size_t i = 0; i < stats.samples; ++i) {
+            sum += samples[i];
+            stats.minMs = std::min(stats.minMs, samples[i]);
+        }
+        stats.avgMs = sum / stats.samples;
+
+        std::size_t p99Index = (stats.samples * 99) / 100;
+        p99Index = std::min(p99Index, stats.samples - 1);
+        std::nth_element(samples.begin(), samples.begin() + p99Index, samples.begin() + stats.samples);
+        stats.p99Ms = samples[p99Index];
+        return stats;
+    }
+
+    bool Profiler::dumpCsv(const std::string& path) const
+    {
+        std::ofstream out(path);
+        if (!out) {
+            log_err << "Failed to open profiler dump: " << path;
+            return false;
+        }
+
+        out << "section,frame,ms\n";
+        std::array<float, RING_SIZE> samples;
+        std::array<std::uint32_t, RING_SIZE> frames;
+
+        std::size_t sectionCount = getSectionCount();
+        for (std::size_t id = 0; id < sectionCount; ++id) {
+            std::string name = getSectionName(id);
+            std::size_t count = snapshot(id, samples.data(), frames.data());
+            for (std::size_t i = 0; i < count; ++i) {
+                out << name << "," << frames[i] << "," << samples[i] << "\n";
+            }
+        }
+
+        log_info << "Profiler samples written to " << path;
+        return true;
+    }
+
+    std::size_t Profiler::getSectionId(const char* name)
+    {
+        std::lock_guard<std::mutex> lock(sectionMutex);
+        auto it = std::find(sectionNames.begin(), sectionNames.end(), name);
+        if (it != sectionNames.end()) {
+            return static_cast<std::size_t>(it - sectionNames.begin());
+        }
+        if (sectionNames.size() >= MAX_SECTIONS) {
+            log_err << "Too many profiler sections, ignoring: " << name;
+            return MAX_SECTIONS;
+        }
+        sectionNames.emplace_back(name);
+        return sectionNames.size() - 1;
+    }
+
+    std::size_t Profiler::getSectionCount()
+    {
+        std::lock_guard<std::mutex> lock(sectionMutex);
+        return sectionNames.size();
+    }
+
+    std::string Profiler::getSectionName(std::size_t sectionId)
+    {
+        std::lock_guard<std::mutex> lock(sectionMutex);
+        return sectionId < sectionNames.size() ? sectionNames[sectionId] : std::string();
+    }
+
+    Profiler* Profiler::getCurrent()
+    {
+        return currentProfiler;
+    }
+
+    void Profiler::setCurrent(Profiler* profiler)
+    {
+        currentProfiler = profiler;
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Times the enclosing scope into the current thread's profiler, if any
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) \
+    static const std::size_t PROFILE_CONCAT(profileSection, __LINE__) = Utils::Profiler::getSectionId(name); \
+    Utils::ScopedTimer PROFILE_CONCAT(profileTimer, __LINE__)(PROFILE_CONCAT(profileSection, __LINE__))
+
+namespace Utils {
+
+    // Per-section ring buffers of timing samples.
+    // Writers claim a slot with one atomic increment and never block; readers
+    // (HUD, CSV dump) take a snapshot and at worst see a slot being overwritten.
+    class Profiler {
+    public:
+        static constexpr std::size_t MAX_SECTIONS = 64;
+        static constexpr std::size_t RING_SIZE = 512;
+
+        struct Stats {
+            float minMs = 0.f;
+            float avgMs = 0.f;
+            float p99Ms = 0.f;
+            std::size_t samples = 0;
+        };
+
+        Profiler();
+
+        // Prevent Copying
+        Profiler(const Profiler&) = delete;
+        Profiler& operator=(const Profiler&) = delete;
+
+        void beginFrame() { frame.fetch_add(1, std::memory_order_relaxed); }
+        void record(std::size_t sectionId, float ms);
+
+        Stats getStats(std::size_t sectionId) const;
+        bool dumpCsv(const std::string& path) const;
+
+        // Section names are shared by all profilers, ids are stable for the process
+        static std::size_t getSectionId(const char* name);
+        static std::size_t getSectionCount();
+        static std::string getSectionName(std::size_t sectionId);
+
+        // Profiler that PROFILE_SCOPE records into on this thread (may be null)
+        static Profiler* getCurrent();
+        static void setCurrent(Profiler* profiler);
+
+    private:
+        struct Ring {
+            std::array<std::atomic<float>, RING_SIZE> ms;
+            std::array<std::atomic<std::uint32_t>, RING_SIZE> frames;
+            std::atomic<std::uint32_t> writeIndex;
+        };
+
+        std::unique_ptr<Ring[]> rings;
+        std::atomic<std::uint32_t> frame{0};
+
+        // Copies the valid samples of a section, oldest first; returns the count
+        std::size_t snapshot(std::size_t sectionId, float* ms, std::uint32_t* frames) const;
+    };
+
+    class ScopedTimer {
+    private:
+        Profiler* profiler;
+        std::size_t sectionId;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        explicit ScopedTimer(std::size_t sectionId) : profiler(Profiler::getCurrent()), sectionId(sectionId) {
+            if (profiler) {
+                start = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~ScopedTimer() {
+            if (profiler) {
+                std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+                profiler->record(sectionId, elapsed.count());
+            }
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    };
+}
+
+#endif // PROFILER_HPP
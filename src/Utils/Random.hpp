@@ -4,12 +4,25 @@
 #include <random>
 
 namespace Utils{
-    float getRandomFloat(float min, float max) {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
+    // Process-wide engine for tools; a simulation draws from its own (GameEntityManager::getRandomEngine)
+    inline std::mt19937& getRandomEngine() {
+        static std::mt19937 gen(std::random_device{}());
+        return gen;
+    }
+
+    inline void seedRandom(unsigned int seed) {
+        getRandomEngine().seed(seed);
+    }
+
+    inline float getRandomFloat(std::mt19937& gen, float min, float max) {
         std::uniform_real_distribution<float> dist(min, max);
         return dist(gen);
     }
+
+    inline float getRandomFloat(float min, float max) {
+        std::uniform_real_distribution<float> dist(min, max);
+        return dist(getRandomEngine());
+    }
 }
 
 #endif // RANDOM_HPP
\ No newline at end of file
@@ -2,20 +2,91 @@
 #include <TGUI/TGUI.hpp>
 #include <TGUI/Backend/SFML-Graphics.hpp>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <ctime>
 
 #include "gui.hpp"
 #include "Game/Scene.hpp"
+#include "Game/Simulation.hpp"
 #include "Config.hpp"
+#include "Utils/Logger.hpp"
+
+struct LaunchOptions {
+    bool headless = false;
+    unsigned long ticks = 60 * 60 * 10; // 10 minutes of game time at 60 ticks/s
+    unsigned int seed = 0;
+    unsigned int tickRate = Config::SIMULATION_TICK_HZ;
+};
+
+LaunchOptions parseArguments(int argc, char* argv[]) {
+    LaunchOptions options;
+    options.seed = static_cast<unsigned int>(time(NULL));
+
+    const auto usage = [&](){
+        log_info << "Usage: " << argv[0] << " [--headless] [--ticks N] [--seed S] [--tick-rate HZ]";
+    };
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        try {
+            if (arg == "--headless") {
+                options.headless = true;
+            } else if (arg == "--ticks" && i + 1 < argc) {
+                options.ticks = std::stoul(argv[++i]);
+            } else if (arg == "--seed" && i + 1 < argc) {
+                options.seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+            } else if (arg == "--tick-rate" && i + 1 < argc) {
+                options.tickRate = static_cast<unsigned int>(std::stoul(argv[++i]));
+                if (options.tickRate == 0) {
+                    log_err << "--tick-rate must be positive, using " << Config::SIMULATION_TICK_HZ;
+                    options.tickRate = Config::SIMULATION_TICK_HZ;
+                }
+            } else {
+                log_err << "Unknown argument: " << arg;
+                usage();
+            }
+        } catch (const std::exception&) {
+            // Not a number, or out of range: the default stays
+            log_err << "Invalid value for " << arg << ": " << argv[i];
+            usage();
+        }
+    }
+    return options;
+}
+
+int runHeadless(const LaunchOptions& options) {
+    Game::Simulation simulation(options.seed, true);
+
+    sf::Clock clock;
+    while (simulation.getTickCount() < options.ticks && !simulation.isGameOver()) {
+        simulation.step(1.f / options.tickRate);
+    }
+    float elapsed = clock.getElapsedTime().asSeconds();
+
+    log_info << "Headless run finished: "
+             << simulation.getTickCount() << " ticks in " << elapsed << " s ("
+             << (elapsed > 0.f ? simulation.getTickCount() / elapsed : 0.f) << " ticks/s), "
+             << "game over: " << (simulation.isGameOver() ? "yes" : "no") << ", "
+             << "winner: " << static_cast<unsigned int>(simulation.getWinner());
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    auto options = parseArguments(argc, argv);
 
-int main() {
     // seed srand
-    srand(time(NULL));
+    srand(options.seed);
+
+    if (options.headless) {
+        return runHeadless(options);
+    }
 
     // Create Window
     sf::RenderWindow window(sf::VideoMode(Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT), "Fleet Commander");
     window.setFramerateLimit(60);
 
-    Scene scene(window);
+    Scene scene(window, options.seed, options.tickRate);
     auto time = sf::Clock();
 
     // Game Loop
@@ -29,7 +100,8 @@ int main() {
             //     window.close();
             // }
             
-            if(event.type == sf::Event::MouseButtonPressed) {
+            // Drags need moves and releases too (box selection)
+            if(event.type == sf::Event::MouseButtonPressed || event.type == sf::Event::MouseButtonReleased || event.type == sf::Event::MouseMoved) {
                 scene.handleInput(event);
             }
 
@@ -38,7 +110,7 @@ int main() {
             }
         }
 
-        // Update logic
+        // The simulation ticks on its own thread, this only takes its latest snapshot
         scene.update(time.restart().asSeconds());
 
         // Render window